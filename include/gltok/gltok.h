@@ -0,0 +1,244 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        include/gltok/gltok.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Glich script tokenizer library header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace gltok {
+
+    // Token kinds. The values are also used as the editor style numbers.
+    enum class TokenKind : unsigned char {
+        Default = 0,
+        Comment = 1,
+        Number = 2,
+        String = 3,
+        Keyword = 4,
+        Identifier = 5,
+        Operator = 6
+    };
+
+    // Lexer state at the end of a line or block of text, used to resume
+    // tokenizing from that point.
+    enum class LexState : unsigned char {
+        Default = 0,
+        Comment = 1,
+        String = 2
+    };
+
+    struct Token
+    {
+        TokenKind kind;
+        size_t start;  // Offset from the start of the text.
+        size_t length;
+    };
+
+    // Character class flags, looked up in char_class.
+    enum : unsigned char {
+        CC_DIGIT = 0x01,
+        CC_IDSTART = 0x02,
+        CC_IDCHAR = 0x04,
+        CC_OPERATOR = 0x08,
+        CC_QUOTE = 0x10,
+        CC_EOL = 0x20,
+        CC_TOKENSTART = CC_DIGIT | CC_IDSTART | CC_OPERATOR | CC_QUOTE
+    };
+
+    constexpr unsigned char char_class_of( unsigned char c )
+    {
+        unsigned char cc = 0;
+        if( c >= '0' && c <= '9' ) {
+            cc |= CC_DIGIT | CC_IDCHAR;
+        }
+        if( (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':' ) {
+            cc |= CC_IDSTART | CC_IDCHAR;
+        }
+        for( const char* op = "+-*/%&|^=<>!.,;()[]{}"; *op; ++op ) {
+            if( c == static_cast<unsigned char>( *op ) ) {
+                cc |= CC_OPERATOR;
+            }
+        }
+        if( c == '"' ) {
+            cc |= CC_QUOTE;
+        }
+        if( c == '\n' || c == '\r' ) {
+            cc |= CC_EOL;
+        }
+        return cc;
+    }
+
+    struct CharClassTable
+    {
+        unsigned char cls[256];
+    };
+
+    constexpr CharClassTable make_char_class_table()
+    {
+        CharClassTable table = {};
+        for( int c = 0; c < 256; ++c ) {
+            table.cls[c] = char_class_of( static_cast<unsigned char>( c ) );
+        }
+        return table;
+    }
+
+    inline constexpr CharClassTable char_class = make_char_class_table();
+
+    inline unsigned char char_class_at( const char* p )
+    {
+        return char_class.cls[static_cast<unsigned char>( *p )];
+    }
+
+    bool is_keyword( std::string_view word );
+
+    // Splits Glich script text into tokens. Every character of the text
+    // belongs to exactly one token, runs of whitespace and unrecognised
+    // characters being returned as TokenKind::Default.
+    class Tokenizer
+    {
+    public:
+        Tokenizer( std::string_view text, LexState state = LexState::Default )
+            : m_text( text ), m_pos( 0 ), m_state( state ) {}
+
+        // Sets token to the next token and returns true, or returns false
+        // at the end of the text.
+        bool next( Token& token );
+
+        // The lexer state at the current position.
+        LexState state() const { return m_state; }
+
+    private:
+        size_t scan_comment( size_t pos );
+        size_t scan_string( size_t pos );
+
+        std::string_view m_text;
+        size_t m_pos;
+        LexState m_state;
+    };
+
+    // Results from styling a single line.
+    struct LineInfo
+    {
+        LexState state;  // Lexer state at the end of the line.
+        int opens;       // Number of { operators in the line.
+        int closes;      // Number of } operators in the line.
+    };
+
+    // Styles one line of text, including its end of line characters,
+    // writing one TokenKind value per character into styles. Braces are
+    // only counted when they are operators, not inside strings or comments.
+    LineInfo style_line( std::string_view line, LexState state, char* styles );
+
+    // Returns true if the last token of the line, ignoring whitespace and
+    // comments, is the operator '{'.
+    bool line_opens_block( std::string_view line, LexState state );
+
+    // Fold levels and flags, with the same values as Scintilla's.
+    constexpr int FOLD_LEVEL_BASE = 0x400;
+    constexpr int FOLD_LEVEL_HEADER_FLAG = 0x2000;
+
+    // The line state holds the LexState at the end of the line in the low
+    // byte and the fold level of the following line above it, so that
+    // styling and folding can resume from any line without rescanning.
+    constexpr int LINESTATE_LEXMASK = 0xFF;
+    constexpr int LINESTATE_LEVELSHIFT = 8;
+
+    inline LexState line_lex_state( int lineState )
+    {
+        return static_cast<LexState>( lineState & LINESTATE_LEXMASK );
+    }
+
+    // A document as Styler sees it: its text, and the styles, line state and
+    // fold level that an editor keeps for each line. Positions are byte
+    // offsets into the text.
+    class StyleDocument
+    {
+    public:
+        virtual int line_count() const = 0;
+        virtual int line_from_position( size_t pos ) const = 0;
+        virtual size_t line_start( int line ) const = 0;
+        virtual size_t line_length( int line ) const = 0;
+        // The text from start on, valid until the document is changed.
+        virtual const char* text( size_t start, size_t length ) = 0;
+        virtual int line_state( int line ) const = 0;
+        virtual void set_line_state( int line, int state ) = 0;
+        virtual int fold_level( int line ) const = 0;
+        virtual void set_fold_level( int line, int level ) = 0;
+        // The text before this position is styled.
+        virtual size_t end_styled() const = 0;
+        // Set the styles from start on, which marks the text up to their
+        // end as styled.
+        virtual void set_styles( size_t start, const char* styles, size_t length ) = 0;
+        // Mark the text up to pos as styled, keeping the styles it has.
+        virtual void set_end_styled( size_t pos ) = 0;
+
+    protected:
+        ~StyleDocument() = default;
+    };
+
+    // Colours and folds a StyleDocument in a single pass, from the first
+    // unstyled line on. It is told of every edit, so that past the edited
+    // lines it can stop as soon as a line ends with the same line state it
+    // was saved with, as every line after it that was styled before is then
+    // unchanged too.
+    class Styler
+    {
+    public:
+        // Call after every change to the text, with the line the change
+        // starts on and the number of lines added, or minus the number of
+        // lines removed.
+        void text_changed( int line, int linesAdded );
+
+        // Colour and fold from the first unstyled line up to and including
+        // endLine, or less if the styles converge first. Returns the number
+        // of fold levels that changed.
+        int style_to_line( StyleDocument& doc, int endLine );
+
+    private:
+        int m_styledLines = 0;  // Lines before this have been styled at least once.
+        int m_changedLine = -1; // Last line edited since it was styled, or -1.
+        std::vector<char> m_styles;
+    };
+
+    struct Range
+    {
+        size_t start;
+        size_t length;
+    };
+
+    // Split a script into its top level statements. A statement ends with a
+    // ';' outside of any brackets. One that starts with a block, or with a
+    // keyword such as function or if that is followed by one, also ends with
+    // the '}' that closes an outermost block, unless that is followed by else
+    // or elseif. Braces within other statements, as in "let x = {a} + b;",
+    // do not end them. Whitespace and comments between statements are not
+    // included in any range.
+    std::vector<Range> top_level_statements( std::string_view script );
+
+}
+
+// End of include/gltok/gltok.h file
@@ -26,10 +26,14 @@
 
 #include <wx/wx.h>
 
+#include "geApp.h"
 #include "geMainFrame.h"
+#include "geRunner.h"
 
 #include <glc/hic.h>
 
+#include <future>
+
 class GeInOut : public glich::InOut
 
 {
@@ -39,6 +43,23 @@ public:
 
 std::string GeInOut::get_input( const std::string& prompt )
 {
+    geRunner::NoteInputRequest();
+    if( !wxIsMainThread() ) {
+        // Scripts are run on a worker thread, so have the GUI thread show
+        // the dialog and wait for the answer.
+        if( geRunner::IsCancelRequested() ) {
+            return std::string();
+        }
+        std::promise<std::string> answer;
+        std::future<std::string> result = answer.get_future();
+        wxTheApp->CallAfter( [this, &prompt, &answer]() {
+            answer.set_value( get_input( prompt ) );
+        } );
+        return result.get();
+    }
+    if( geRunner::IsCancelRequested() ) {
+        return std::string();
+    }
     wxTextEntryDialog dialog(
         nullptr, prompt,
         _( "Gliched Input" ), "", wxOK | wxCANCEL
@@ -50,46 +71,57 @@ std::string GeInOut::get_input( const std::string& prompt )
 }
 
 
-class GlichedApp : public wxApp
+bool GlichedApp::OnInit()
 {
-public:
-    bool OnInit() override
-    {
-        glich::StdStrVec args;
-        for( int i = 0; i < argc; i++ ) {
-            args.push_back( std::string( argv[i] ) );
-        }
-        glich::InitLibrary lib = glich::InitLibrary::Hics;
-        wxString filename;
-        if( argc > 1 ) {
-            if( argv[1] == "--lib" && argc > 2 ) {
-                wxString libname = argv[2];
-                if( libname == "none" ) {
-                    lib = glich::InitLibrary::None;
-                }
-                else if( libname == "hics" ) {
-                    lib = glich::InitLibrary::Hics;
-                }
-                if( argc > 3 ) {
-                    filename = argv[3];
-                }
+    for( int i = 0; i < argc; i++ ) {
+        m_args.push_back( std::string( argv[i] ) );
+    }
+    wxString library = "hics";
+    wxString filename;
+    if( argc > 1 ) {
+        if( argv[1] == "--lib" && argc > 2 ) {
+            wxString libname = argv[2];
+            if( libname == "none" ) {
+                m_lib = glich::InitLibrary::None;
+                library = libname;
+            }
+            else if( libname == "hics" ) {
+                m_lib = glich::InitLibrary::Hics;
+                library = libname;
             }
-            else {
-                filename = argv[1];
+            if( argc > 3 ) {
+                filename = argv[3];
             }
         }
-        glich::init_hic( lib, new GeInOut, args );
-
-        geMainFrame* frame = new geMainFrame( filename );
-        frame->Show();
-        return true;
+        else {
+            filename = argv[1];
+        }
     }
+    glich::init_hic( m_lib, new GeInOut, m_args );
 
-    int OnExit() override
-    {
+    geMainFrame* frame = new geMainFrame( filename, library );
+    frame->Show();
+    return true;
+}
+
+int GlichedApp::OnExit()
+{
+    // A script that could not be stopped may still be using the
+    // interpreter, in which case it is left for the process to clean up.
+    if( !geRunner::IsActive() ) {
         glich::exit_hic();
-        return 0;
     }
-};
+    return 0;
+}
+
+bool GlichedApp::ResetInterpreter()
+{
+    if( geRunner::IsActive() ) {
+        return false;
+    }
+    glich::exit_hic();
+    glich::init_hic( m_lib, new GeInOut, m_args );
+    return true;
+}
 
 wxIMPLEMENT_APP( GlichedApp );
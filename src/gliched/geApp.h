@@ -0,0 +1,48 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geApp.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Program Main Application Header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include <wx/app.h>
+
+#include <glc/hic.h>
+
+class GlichedApp : public wxApp
+{
+public:
+    bool OnInit() override;
+    int OnExit() override;
+
+    // Restart the interpreter in this process, with the library loaded at
+    // startup, for a clean state. Returns false if a script is using it.
+    bool ResetInterpreter();
+
+private:
+    glich::InitLibrary m_lib = glich::InitLibrary::Hics;
+    glich::StdStrVec m_args;
+};
+
+wxDECLARE_APP( GlichedApp );
@@ -0,0 +1,116 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geAtom.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Interned string class.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+
+ */
+
+#include "geAtom.h"
+
+#include <mutex>
+
+namespace {
+
+    // The table is only used with this held. References are counted without
+    // it, as a copy of an atom can't see the count reach zero while the atom
+    // copied from holds one. Once the count has reached zero it stays there,
+    // and the one atom that took it to zero removes and deletes the Rep.
+    std::mutex s_mutex;
+
+}
+
+// Keyed by views of the text held in each Rep.
+std::unordered_map<std::string_view, geAtom::Rep*>& geAtom::Table()
+{
+    static std::unordered_map<std::string_view, Rep*> table;
+    return table;
+}
+
+geAtom::geAtom( std::string_view text )
+    : m_rep( nullptr )
+{
+    if( text.empty() ) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock( s_mutex );
+    auto& table = Table();
+    auto it = table.find( text );
+    if( it != table.end() ) {
+        // A Rep whose last atom has gone, but which is not yet removed,
+        // is replaced rather than revived.
+        size_t refs = it->second->refs.load( std::memory_order_relaxed );
+        while( refs != 0 ) {
+            if( it->second->refs.compare_exchange_weak( refs, refs + 1, std::memory_order_relaxed ) ) {
+                m_rep = it->second;
+                return;
+            }
+        }
+        table.erase( it );
+    }
+    m_rep = new Rep{ { 1 }, std::string( text ) };
+    table.emplace( m_rep->text, m_rep );
+}
+
+geAtom& geAtom::operator=( const geAtom& other )
+{
+    if( m_rep != other.m_rep ) {
+        Release();
+        m_rep = other.m_rep;
+        AddRef();
+    }
+    return *this;
+}
+
+geAtom& geAtom::operator=( geAtom&& other ) noexcept
+{
+    if( this != &other ) {
+        Release();
+        m_rep = other.m_rep;
+        other.m_rep = nullptr;
+    }
+    return *this;
+}
+
+size_t geAtom::Count()
+{
+    std::lock_guard<std::mutex> lock( s_mutex );
+    return Table().size();
+}
+
+void geAtom::Release()
+{
+    if( !m_rep ) {
+        return;
+    }
+    if( m_rep->refs.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) {
+        // The table may already hold a new Rep for the same text.
+        std::lock_guard<std::mutex> lock( s_mutex );
+        auto& table = Table();
+        auto it = table.find( m_rep->text );
+        if( it != table.end() && it->second == m_rep ) {
+            table.erase( it );
+        }
+        delete m_rep;
+    }
+    m_rep = nullptr;
+}
@@ -0,0 +1,77 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geAtom.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Interned string class header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// An immutable string held once in a shared table, however many geAtoms
+// refer to it. Equal strings give the same atom, so atoms compare by
+// pointer. The text is freed when its last atom goes. Atoms may be made
+// and released on any thread.
+class geAtom
+{
+public:
+    geAtom() : m_rep( nullptr ) {}
+    explicit geAtom( std::string_view text );
+    geAtom( const geAtom& other ) : m_rep( other.m_rep ) { AddRef(); }
+    geAtom( geAtom&& other ) noexcept : m_rep( other.m_rep ) { other.m_rep = nullptr; }
+    ~geAtom() { Release(); }
+
+    geAtom& operator=( const geAtom& other );
+    geAtom& operator=( geAtom&& other ) noexcept;
+
+    std::string_view view() const { return m_rep ? std::string_view( m_rep->text ) : std::string_view(); }
+    operator std::string_view() const { return view(); }
+    const char* c_str() const { return m_rep ? m_rep->text.c_str() : ""; }
+    size_t size() const { return m_rep ? m_rep->text.size() : 0; }
+    bool empty() const { return m_rep == nullptr; }
+
+    friend bool operator==( const geAtom& a, const geAtom& b ) { return a.m_rep == b.m_rep; }
+    friend bool operator!=( const geAtom& a, const geAtom& b ) { return a.m_rep != b.m_rep; }
+
+    // The number of distinct strings held.
+    static size_t Count();
+
+private:
+    struct Rep
+    {
+        std::atomic<size_t> refs;
+        std::string text;
+    };
+
+    void AddRef() { if( m_rep ) m_rep->refs.fetch_add( 1, std::memory_order_relaxed ); }
+    void Release();
+
+    static std::unordered_map<std::string_view, Rep*>& Table();
+
+    Rep* m_rep; // Null for the empty string.
+};
@@ -26,31 +26,38 @@
 
 #include "geEditor.h"
 #include "geMainFrame.h"
+
+#include <gltok/gltok.h>
+
 #include <wx/stc/stc.h>
 #include <wx/log.h> 
-#include <unordered_set>
-
-static const std::unordered_set<std::string> glich_keywords = {
-    "let", "global", "constant", "function", "result", "this" "command", "object",
-    "file", "write", "nl", "mark", "call", "set", "module",
-    "if", "else", "elseif",
-    "do", "in", "in:r", "while", "until", "exit",
-    "true", "false", "null", "empty", "infinity", "inf", "nan",
-    "and", "or", "not",
-    "grammar", "format", "lexicon",
-    "past", "future", "today"
-};
+#include <wx/stopwatch.h>
+
+#include <algorithm>
+#include <string_view>
 
 enum {
-    STYLE_DEFAULT = 0,
-    STYLE_COMMENT = 1,
-    STYLE_NUMBER = 2,
-    STYLE_STRING = 3,
-    STYLE_KEYWORD = 4,
-    STYLE_IDENTIFIER = 5,
-    STYLE_OPERATOR = 6
+    STYLE_DEFAULT = static_cast<int>( gltok::TokenKind::Default ),
+    STYLE_COMMENT = static_cast<int>( gltok::TokenKind::Comment ),
+    STYLE_NUMBER = static_cast<int>( gltok::TokenKind::Number ),
+    STYLE_STRING = static_cast<int>( gltok::TokenKind::String ),
+    STYLE_KEYWORD = static_cast<int>( gltok::TokenKind::Keyword ),
+    STYLE_IDENTIFIER = static_cast<int>( gltok::TokenKind::Identifier ),
+    STYLE_OPERATOR = static_cast<int>( gltok::TokenKind::Operator )
 };
 
+// Lines beyond the visible text are styled in the background, in chunks of
+// IDLE_STYLE_LINES, for up to IDLE_STYLE_BUDGET_MS per idle event.
+constexpr int IDLE_STYLE_LINES = 1000;
+constexpr long IDLE_STYLE_BUDGET_MS = 10;
+
+// Profile times are shown in the heat margin as HEAT_LEVELS shades, using
+// markers 0 to HEAT_LEVELS-1, from pale yellow for the quickest statements
+// to red for the slowest.
+constexpr int HEAT_MARGIN = 2;
+constexpr int HEAT_LEVELS = 8;
+constexpr int HEAT_MARGIN_WIDTH = 8;
+
 geEditor::geEditor(wxWindow* parent)
     : wxStyledTextCtrl( parent, wxID_ANY ), m_runPage( false )
 {
@@ -94,6 +101,16 @@ geEditor::geEditor(wxWindow* parent)
     MarkerDefine(wxSTC_MARKNUM_FOLDEROPENMID, wxSTC_MARK_ARROWDOWN, *wxBLACK, wxColour(200, 200, 200));
     MarkerDefine(wxSTC_MARKNUM_FOLDERMIDTAIL, wxSTC_MARK_TCORNER, *wxBLACK, wxColour(200, 200, 200));
 
+    // Profiler heat margin, hidden until there is a profile to show.
+    SetMarginType( HEAT_MARGIN, wxSTC_MARGIN_SYMBOL );
+    SetMarginMask( HEAT_MARGIN, ( 1 << HEAT_LEVELS ) - 1 );
+    SetMarginWidth( HEAT_MARGIN, 0 );
+    for( int level = 0; level < HEAT_LEVELS; level++ ) {
+        int shade = 224 - level * 224 / ( HEAT_LEVELS - 1 );
+        wxColour colour( 255, shade, level == 0 ? 160 : 0 );
+        MarkerDefine( level, wxSTC_MARK_FULLRECT, colour, colour );
+    }
+
     SetProperty("fold", "1");
     SetProperty("fold.compact", "1");
 
@@ -106,6 +123,8 @@ geEditor::geEditor(wxWindow* parent)
     Bind( wxEVT_STC_MARGINCLICK, &geEditor::OnMarginClick, this );
     Bind(wxEVT_STC_CHARADDED, &geEditor::OnCharAdded, this);
     Bind( wxEVT_STC_CHANGE, &geEditor::OnContentChanged, this );
+    Bind( wxEVT_STC_MODIFIED, &geEditor::OnModified, this );
+    Bind( wxEVT_IDLE, &geEditor::OnIdle, this );
     m_autosaveTimer.Bind( wxEVT_TIMER, &geEditor::OnAutosaveTimer, this );
 }
 
@@ -119,181 +138,131 @@ bool geEditor::LoadFile( const wxString& path )
     return false;
 }
 
+// Copy the document straight from the Scintilla buffer, which already holds
+// UTF-8, without going through a wxString.
+std::string geEditor::GetUtf8Text()
+{
+    return std::string( GetCharacterPointer(), GetTextLength() );
+}
+
+// Mark each profiled statement in the heat margin, scaled to the slowest.
+void geEditor::SetHeatMap( const geProfile& profile )
+{
+    ClearHeatMap();
+    double slowest = 0.0;
+    for( const geProfileEntry& entry : profile ) {
+        slowest = std::max( slowest, entry.seconds );
+    }
+    if( slowest <= 0.0 ) {
+        return;
+    }
+    for( const geProfileEntry& entry : profile ) {
+        int level = std::min( HEAT_LEVELS - 1, static_cast<int>( entry.seconds / slowest * HEAT_LEVELS ) );
+        for( int line = entry.line; line < entry.line + entry.lineCount; line++ ) {
+            MarkerAdd( line, level );
+        }
+    }
+    SetMarginWidth( HEAT_MARGIN, HEAT_MARGIN_WIDTH );
+}
+
+void geEditor::ClearHeatMap()
+{
+    for( int level = 0; level < HEAT_LEVELS; level++ ) {
+        MarkerDeleteAll( level );
+    }
+    SetMarginWidth( HEAT_MARGIN, 0 );
+}
+
 bool geEditor::SaveFile( const wxString& path )
 {
     if( wxStyledTextCtrl::SaveFile( path ) ) {
         m_filename = path;
         m_tabName = wxFileNameFromPath( path );
+        geMainFrame* frame = dynamic_cast<geMainFrame*>(wxGetTopLevelParent( this ));
+        if( frame ) {
+            frame->EditorSaved( this );
+        }
         return true;
     }
     return false;
 }
 
-// Helper: Returns true if inside a /* ... */ comment at the given position
-static bool IsInMultilineComment(int pos, wxStyledTextCtrl* ctrl)
+void geEditor::OnStyleNeeded(wxStyledTextEvent& event)
 {
-    bool inComment = false;
-    int i = 0;
-    while (i < pos) {
-        char c = ctrl->GetCharAt(i);
-        if (!inComment && c == '/' && ctrl->GetCharAt(i + 1) == '*') {
-            inComment = true;
-            i += 2;
-            continue;
-        }
-        if (inComment && c == '*' && ctrl->GetCharAt(i + 1) == '/') {
-            inComment = false;
-            i += 2;
-            continue;
-        }
-        ++i;
-    }
-    return inComment;
+    // Scintilla asks for styling up to the end of the visible text. Style a
+    // page more than that so that scrolling down does not have to wait,
+    // and leave the rest of the document to OnIdle.
+    int endLine = LineFromPosition( event.GetPosition() ) + LinesOnScreen();
+    StyleToLine( std::min( endLine, GetLineCount() - 1 ) );
 }
 
-// Folding logic for { ... } blocks
-void geEditor::OnStyleNeeded(wxStyledTextEvent& event)
+// The editor's text and per line data, as gltok::Styler sees them.
+class geEditorDocument : public gltok::StyleDocument
 {
-    // Folding logic.
-    int lineCount = GetLineCount();
-    int level = wxSTC_FOLDLEVELBASE;
-
-    for( int line = 0; line < lineCount; ++line ) {
-        wxString text = GetLine( line );
-
-        // Count braces in this line
-        int opens = 0, closes = 0;
-        for( wxChar ch : text ) {
-            if( ch == '{' ) ++opens;
-            if( ch == '}' ) ++closes;
-        }
-
-        // Set fold level for this line
-        int thisLevel = level;
-        int nextLevel = level + opens - closes;
+public:
+    explicit geEditorDocument( geEditor& editor ) : m_editor( editor ) {}
+
+    int line_count() const override { return m_editor.GetLineCount(); }
+    int line_from_position( size_t pos ) const override { return m_editor.LineFromPosition( static_cast<int>( pos ) ); }
+    size_t line_start( int line ) const override { return m_editor.PositionFromLine( line ); }
+    size_t line_length( int line ) const override { return m_editor.LineLength( line ); }
+    const char* text( size_t start, size_t length ) override
+    {
+        return m_editor.GetRangePointer( static_cast<int>( start ), static_cast<int>( length ) );
+    }
+    int line_state( int line ) const override { return m_editor.GetLineState( line ); }
+    void set_line_state( int line, int state ) override { m_editor.SetLineState( line, state ); }
+    int fold_level( int line ) const override { return m_editor.GetFoldLevel( line ); }
+    void set_fold_level( int line, int level ) override { m_editor.SetFoldLevel( line, level ); }
+    size_t end_styled() const override { return m_editor.GetEndStyled(); }
+    void set_styles( size_t start, const char* styles, size_t length ) override
+    {
+        // SetStyleBytes only reads the styles, though it takes a char*.
+        m_editor.StartStyling( static_cast<int>( start ) );
+        m_editor.SetStyleBytes( static_cast<int>( length ), const_cast<char*>( styles ) );
+    }
+    void set_end_styled( size_t pos ) override { m_editor.StartStyling( static_cast<int>( pos ) ); }
 
-        int flags = thisLevel;
-        if( opens > 0 ) {
-            flags |= wxSTC_FOLDLEVELHEADERFLAG;
-        }
+private:
+    geEditor& m_editor;
+};
 
-        SetFoldLevel( line, flags );
+// Colour and fold from the first unstyled line up to and including endLine.
+void geEditor::StyleToLine( int endLine )
+{
+    geEditorDocument document( *this );
+    m_styler.style_to_line( document, endLine );
+}
 
-        // The next line's level is increased if a block is opened
-        level = thisLevel + opens - closes;
-        if( level < wxSTC_FOLDLEVELBASE ) {
-            level = wxSTC_FOLDLEVELBASE;
-        }
+// Tell the styler which lines each edit changes, so that it knows which
+// old styles it can keep.
+void geEditor::OnModified( wxStyledTextEvent& event )
+{
+    event.Skip();
+    if( !(event.GetModificationType() & (wxSTC_MOD_INSERTTEXT | wxSTC_MOD_DELETETEXT)) ) {
+        return;
     }
+    m_styler.text_changed( LineFromPosition( event.GetPosition() ), event.GetLinesAdded() );
+}
 
-    // Syntax colouring.
-    int startPos = GetEndStyled();
-    int endPos = event.GetPosition();
-    StartStyling(startPos);
-
+// Style the rest of the document in the background, a chunk of lines at a
+// time, until the time budget for this idle event is used up.
+void geEditor::OnIdle( wxIdleEvent& event )
+{
+    event.Skip();
     int length = GetTextLength();
-    int pos = startPos;
-
-    // Fix: determine if we are inside a multi-line comment at startPos
-    bool inComment = IsInMultilineComment(startPos, this);
-
-    while (pos < endPos && pos < length) {
-        char c = GetCharAt(pos);
-
-        // Multi-line comment start or inside comment
-        if (!inComment && c == '/' && GetCharAt(pos + 1) == '*') {
-            int start = pos;
-            pos += 2;
-            inComment = true;
-            while (pos < endPos && pos < length) {
-                if (GetCharAt(pos) == '*' && GetCharAt(pos + 1) == '/') {
-                    pos += 2;
-                    inComment = false;
-                    break;
-                }
-                ++pos;
-            }
-            SetStyling(pos - start, STYLE_COMMENT);
-            continue;
-        }
-        if (inComment) {
-            int start = pos;
-            while (pos < endPos && pos < length) {
-                if (GetCharAt(pos) == '*' && GetCharAt(pos + 1) == '/') {
-                    pos += 2;
-                    inComment = false;
-                    break;
-                }
-                ++pos;
-            }
-            SetStyling(pos - start, STYLE_COMMENT);
-            continue;
-        }
-
-        // Single-line comment (// to end of line)
-        if (c == '/' && GetCharAt(pos + 1) == '/') {
-            int lineEnd = PositionFromLine(LineFromPosition(pos) + 1);
-            if (lineEnd == wxNOT_FOUND) lineEnd = length;
-            int n = lineEnd - pos;
-            SetStyling(n, STYLE_COMMENT);
-            pos += n;
-            continue;
-        }
-
-        // String
-        if (c == '"') {
-            int start = pos;
-            ++pos;
-            while (pos < endPos && pos < length) {
-                char d = GetCharAt(pos);
-                if (d == '"' && GetCharAt(pos + 1) == '"') { // Escaped quote
-                    pos += 2;
-                } else if (d == '"') {
-                    ++pos;
-                    break;
-                } else {
-                    ++pos;
-                }
-            }
-            SetStyling(pos - start, STYLE_STRING);
-            continue;
-        }
-
-        // Number
-        if (isdigit(c)) {
-            int start = pos;
-            while (pos < endPos && isdigit(GetCharAt(pos))) ++pos;
-            SetStyling(pos - start, STYLE_NUMBER);
-            continue;
-        }
-
-        // Identifier (allowing : and _)
-        if (isalpha(c) || c == '_' || c == ':') {
-            int start = pos;
-            while (pos < endPos) {
-                char d = GetCharAt(pos);
-                if (isalnum(d) || d == '_' || d == ':')
-                    ++pos;
-                else
-                    break;
-            }
-            wxString ident = GetTextRange(start, pos);
-            std::string identStr = ident.ToStdString();
-            int style = glich_keywords.count(identStr) ? STYLE_KEYWORD : STYLE_IDENTIFIER;
-            SetStyling(pos - start, style);
-            continue;
-        }
-
-        // Operator
-        if (strchr("+-*/%&|^=<>!.,;()[]{}", c)) {
-            SetStyling(1, STYLE_OPERATOR);
-            ++pos;
-            continue;
-        }
-
-        // Whitespace or default
-        SetStyling(1, STYLE_DEFAULT);
-        ++pos;
+    if( GetEndStyled() >= length ) {
+        return;
+    }
+    int lastLine = GetLineCount() - 1;
+    wxStopWatch sw;
+    do {
+        int line = LineFromPosition( GetEndStyled() );
+        StyleToLine( std::min( line + IDLE_STYLE_LINES, lastLine ) );
+    } while( GetEndStyled() < length && sw.Time() < IDLE_STYLE_BUDGET_MS );
+
+    if( GetEndStyled() < length ) {
+        event.RequestMore();
     }
 }
 
@@ -327,9 +296,13 @@ void geEditor::OnCharAdded(wxStyledTextEvent& event)
             }
         }
 
-        // Increase indent if previous line ends with '{'
-        wxString trimmedPrev = prevLine.Trim(true).Trim(false);
-        if (trimmedPrev.EndsWith("{")) {
+        // Increase indent if previous line ends with '{', ignoring any
+        // trailing comment
+        int prevStart = PositionFromLine( line - 1 );
+        int prevLength = LineLength( line - 1 );
+        gltok::LexState prevState = (line > 1) ? gltok::line_lex_state( GetLineState( line - 2 ) ) : gltok::LexState::Default;
+        std::string_view prevText( GetRangePointer( prevStart, prevLength ), prevLength );
+        if( gltok::line_opens_block( prevText, prevState ) ) {
             if (GetUseTabs())
                 indent += '\t';
             else
@@ -406,6 +379,9 @@ void geEditor::OnContentChanged( wxStyledTextEvent& )
     // Only start timer if autosave is enabled (ask main frame)
     if( m_filename.IsEmpty() ) return;
     geMainFrame* frame = dynamic_cast<geMainFrame*>(wxGetTopLevelParent( this ));
+    if( frame ) {
+        frame->EditorChanged( this );
+    }
     if( frame && frame->IsAutosaveEnabled() ) {
         m_autosaveTimer.Start( 1000, wxTIMER_ONE_SHOT ); // 1 second debounce
     }
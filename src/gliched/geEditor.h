@@ -26,9 +26,15 @@
 
 #pragma once
 
+#include "geProfile.h"
+
+#include <gltok/gltok.h>
+
 #include <wx/stc/stc.h>
 #include <wx/timer.h>
 
+#include <string>
+
 class geEditor : public wxStyledTextCtrl
 {
 public:
@@ -36,6 +42,7 @@ public:
 
     bool LoadFile(const wxString& path);
     bool SaveFile(const wxString& path);
+    std::string GetUtf8Text();
     wxString GetFilename() const { return m_filename; }
     void SetFilename(const wxString& path) { m_filename = path; }
     wxString GetTabName() const { return m_tabName; }
@@ -43,16 +50,24 @@ public:
     bool IsRunPage() const { return m_runPage; }
     void SetRunPage( bool run ) { m_runPage = run; }
 
+    void SetHeatMap( const geProfile& profile );
+    void ClearHeatMap();
+
 private:
     void OnStyleNeeded(wxStyledTextEvent& event);
     void OnMarginClick( wxStyledTextEvent& event );
     void OnCharAdded(wxStyledTextEvent& event);
     void OnUpdateUI( wxStyledTextEvent& );
     void OnContentChanged( wxStyledTextEvent& );
+    void OnModified( wxStyledTextEvent& event );
     void OnAutosaveTimer( wxTimerEvent& );
+    void OnIdle( wxIdleEvent& event );
+
+    void StyleToLine( int endLine );
 
     wxString m_filename;
     wxString m_tabName;
     bool m_runPage;
     wxTimer m_autosaveTimer;
+    gltok::Styler m_styler;
 };
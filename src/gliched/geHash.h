@@ -0,0 +1,73 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geHash.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     64 bit FNV-1a hash.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Accumulates a 64 bit FNV-1a hash. Each string is followed by its length
+// so that ("ab","c") and ("a","bc") give different results.
+class geHasher
+{
+public:
+    geHasher() : m_hash( 0xcbf29ce484222325ull ) {}
+    // Start from another offset basis, for a second hash of the same input.
+    explicit geHasher( uint64_t basis ) : m_hash( basis ) {}
+
+    void Add( std::string_view text )
+    {
+        for( unsigned char ch : text ) {
+            m_hash = ( m_hash ^ ch ) * 0x100000001b3ull;
+        }
+        Add( static_cast<uint64_t>( text.size() ) );
+    }
+
+    void Add( uint64_t value )
+    {
+        for( int i = 0; i < 8; i++ ) {
+            m_hash = ( m_hash ^ ( value & 0xFF ) ) * 0x100000001b3ull;
+            value >>= 8;
+        }
+    }
+
+    uint64_t Get() const { return m_hash; }
+
+    static std::string ToHex( uint64_t hash )
+    {
+        static const char digits[] = "0123456789abcdef";
+        std::string hex( 16, '0' );
+        for( int i = 15; i >= 0; i-- ) {
+            hex[i] = digits[hash & 0xF];
+            hash >>= 4;
+        }
+        return hex;
+    }
+
+private:
+    uint64_t m_hash;
+};
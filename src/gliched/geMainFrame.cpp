@@ -26,8 +26,11 @@
 
 #include "geMainFrame.h"
 
+#include "geApp.h"
 #include "geEditor.h"
 #include "geImages.h"
+#include "geModules.h"
+#include "geState.h"
 #include "geVersion.h"
 
 #include <glc/hic.h>
@@ -37,13 +40,32 @@
 #include <wx/msgdlg.h>
 #include <wx/filedlg.h>
 #include <wx/filename.h>
-#include <wx/treelist.h>
+#include <wx/sizer.h>
 #include <wx/bmpbndl.h>
 #include <wx/icon.h>
 #include <wx/image.h>
 #include <wx/mstream.h>
 #include <wx/button.h>
+#include <wx/numdlg.h>
+#include <wx/textdlg.h>
+#include <wx/stdpaths.h>
 
+#include <algorithm>
+#include <thread>
+
+
+// Output is moved from the output buffer to the Output pane every
+// OUTPUT_FLUSH_MS, at most OUTPUT_FLUSH_BYTES at a time.
+constexpr int OUTPUT_FLUSH_MS = 50;
+constexpr size_t OUTPUT_FLUSH_BYTES = 4 * 1024 * 1024;
+
+// Size limit for the result cache. Outputs larger than a quarter of this
+// are not cached.
+constexpr size_t RUN_CACHE_BYTES = 256 * 1024 * 1024;
+
+// In watch mode, a save starts a run after WATCH_DELAY_MS, so that saving
+// several files together gives a single run.
+constexpr int WATCH_DELAY_MS = 250;
 
 enum
 {
@@ -56,10 +78,21 @@ enum
     ID_Cut,
     ID_Copy,
     ID_Paste,
+    ID_Find_Output,
+    ID_Find_Next_Output,
+    ID_Output_Limit,
     ID_Help_Website,
     ID_Help_About,
     ID_Run,
+    ID_Run_Profile,
+    ID_Stop,
     ID_ToggleAutosave,
+    ID_ToggleRunCache,
+    ID_ClearRunCache,
+    ID_ToggleWatch,
+    ID_ToggleSessions,
+    ID_ToggleFreshRuns,
+    ID_ResetState,
     ID_Select_Run_Tab,
     ID_Clear_Run_Tab
 };
@@ -75,8 +108,22 @@ wxBEGIN_EVENT_TABLE(geMainFrame, wxFrame)
     EVT_TOOL( ID_Cut, geMainFrame::OnCut )
     EVT_TOOL( ID_Copy, geMainFrame::OnCopy )
     EVT_TOOL( ID_Paste, geMainFrame::OnPaste )
+    EVT_MENU( ID_Find_Output, geMainFrame::OnFindOutput )
+    EVT_MENU( ID_Find_Next_Output, geMainFrame::OnFindNextOutput )
+    EVT_MENU( ID_Output_Limit, geMainFrame::OnOutputLimit )
     EVT_MENU( ID_Run, geMainFrame::OnRun )
+    EVT_MENU( ID_Run_Profile, geMainFrame::OnRun )
+    EVT_MENU( ID_Stop, geMainFrame::OnStop )
+    EVT_UPDATE_UI( ID_Run, geMainFrame::OnUpdateRun )
+    EVT_UPDATE_UI( ID_Run_Profile, geMainFrame::OnUpdateRun )
+    EVT_UPDATE_UI( ID_Stop, geMainFrame::OnUpdateStop )
     EVT_MENU( ID_ToggleAutosave, geMainFrame::OnToggleAutosave )
+    EVT_MENU( ID_ToggleRunCache, geMainFrame::OnToggleRunCache )
+    EVT_MENU( ID_ClearRunCache, geMainFrame::OnClearRunCache )
+    EVT_MENU( ID_ToggleWatch, geMainFrame::OnToggleWatch )
+    EVT_MENU( ID_ToggleSessions, geMainFrame::OnToggleSessions )
+    EVT_MENU( ID_ToggleFreshRuns, geMainFrame::OnToggleFreshRuns )
+    EVT_MENU( ID_ResetState, geMainFrame::OnResetState )
     EVT_MENU( ID_Help_Website, geMainFrame::OnHelpWebsite )
     EVT_MENU( ID_Help_About, geMainFrame::OnHelpAbout )
     EVT_AUINOTEBOOK_PAGE_CHANGED(wxID_ANY, geMainFrame::OnTabChanged)
@@ -85,11 +132,16 @@ wxBEGIN_EVENT_TABLE(geMainFrame, wxFrame)
     EVT_MENU( ID_Clear_Run_Tab, geMainFrame::OnClearRunFile )
     EVT_CLOSE( geMainFrame::OnClose )
     EVT_BUTTON( ID_Run, geMainFrame::OnRun )
+    EVT_BUTTON( ID_Stop, geMainFrame::OnStop )
 wxEND_EVENT_TABLE()
 
-geMainFrame::geMainFrame( const wxString& filename )
+geMainFrame::geMainFrame( const wxString& filename, const wxString& library )
     : wxFrame(nullptr, wxID_ANY, "Gliched IDE", wxDefaultPosition, wxSize(900, 700)),
-    m_mgr( this ), m_tabContextIndex( -1 ), m_newTabCounter( 1 )
+    m_mgr( this ), m_tabContextIndex( -1 ), m_newTabCounter( 1 ),
+    m_sessions( std::max( 2u, std::thread::hardware_concurrency() ),
+        [this]( geSession* session, const geRunStats& stats ) { OnSessionDone( session, stats ); },
+        [this]( geSession* session, const std::string& prompt ) { AskSessionInput( session, prompt ); },
+        [this]( geSession* session ) { OnSessionClosed( session ); } )
 {
     wxBitmapBundle bundle = wxBitmapBundle::FromSVG( glich_icon_svg, wxSize( 32, 32 ) );
     if( bundle.IsOk() ) {
@@ -120,13 +172,33 @@ geMainFrame::geMainFrame( const wxString& filename )
     editMenu->Append( ID_Cut, "Cu&t\tCtrl+X" );
     editMenu->Append( ID_Copy, "&Copy\tCtrl+C" );
     editMenu->Append( ID_Paste, "&Paste\tCtrl+V" );
+    editMenu->AppendSeparator();
+    editMenu->Append( ID_Find_Output, "&Find in Output...\tCtrl+Shift+F" );
+    editMenu->Append( ID_Find_Next_Output, "Find &Next in Output\tF3" );
     menuBar->Append( editMenu, "&Edit" );
 
     // Tools menu
     wxMenu* toolsMenu = new wxMenu();
     toolsMenu->Append( ID_Run, "&Run script\tF5" );
+    toolsMenu->Append( ID_Run_Profile, "Run with &Profiler\tCtrl+F5" );
+    toolsMenu->Append( ID_Stop, "&Stop script\tShift+F5" );
+    toolsMenu->Append( ID_Output_Limit, "&Output Limit..." );
     wxMenuItem* autosaveItem = toolsMenu->AppendCheckItem( ID_ToggleAutosave, "Toggle Autosave" );
     autosaveItem->Check( m_autosaveEnabled );
+    wxMenuItem* runCacheItem = toolsMenu->AppendCheckItem( ID_ToggleRunCache, "Use Result &Cache" );
+    runCacheItem->Check( m_runCacheEnabled );
+    toolsMenu->Append( ID_ClearRunCache, "C&lear Result Cache" );
+    wxMenuItem* watchItem = toolsMenu->AppendCheckItem( ID_ToggleWatch, "&Watch Mode",
+        "Run the script again whenever it or a module it uses is saved" );
+    watchItem->Check( m_watchEnabled );
+    wxMenuItem* sessionsItem = toolsMenu->AppendCheckItem( ID_ToggleSessions, "Separate &Session per Tab",
+        "Run each tab in its own interpreter process, so that tabs keep their own state and can run at once" );
+    sessionsItem->Check( m_sessionsEnabled );
+    wxMenuItem* freshItem = toolsMenu->AppendCheckItem( ID_ToggleFreshRuns, "&Fresh State for Each Run",
+        "Start every run in a session from the state left by loading the library" );
+    freshItem->Check( m_freshRuns );
+    toolsMenu->Append( ID_ResetState, "R&eset State",
+        "Return the run file's interpreter to the state left by loading the library" );
     menuBar->Append( toolsMenu, "&Tools" );
 
     // Help menu
@@ -155,6 +227,9 @@ geMainFrame::geMainFrame( const wxString& filename )
     wxButton* m_buttonRun = new wxButton( m_toolbar, ID_Run, _( "Run" ), wxDefaultPosition, wxDefaultSize, 0 );
     m_buttonRun->SetToolTip( _( "Run active script [F5]" ) );
     m_toolbar->AddControl( m_buttonRun );
+    wxButton* m_buttonStop = new wxButton( m_toolbar, ID_Stop, _( "Stop" ), wxDefaultPosition, wxDefaultSize, 0 );
+    m_buttonStop->SetToolTip( _( "Stop the running script [Shift+F5]" ) );
+    m_toolbar->AddControl( m_buttonStop );
     m_toolbar->Realize();
 
     // Status bar
@@ -166,27 +241,59 @@ geMainFrame::geMainFrame( const wxString& filename )
     m_notebook->Bind( wxEVT_AUINOTEBOOK_TAB_RIGHT_DOWN, &geMainFrame::OnTabRightClick, this );
 
     // Output pane
-    m_output = new wxTextCtrl( this, wxID_ANY, wxEmptyString,
-        wxDefaultPosition, wxSize( -1, 120 ),
-        wxTE_MULTILINE | wxTE_READONLY | wxTE_RICH2 );
-
-    // State tree (left pane) - wxTreeListCtrl with columns
-    m_stateTree = new wxTreeListCtrl( this, wxID_ANY, wxDefaultPosition, wxSize( 250, -1 ),
-        wxTL_DEFAULT_STYLE | wxTL_MULTIPLE );
-    m_stateTree->AppendColumn( "Type", wxCOL_WIDTH_AUTOSIZE, wxALIGN_LEFT, wxCOL_RESIZABLE );
-    m_stateTree->AppendColumn( "Name", wxCOL_WIDTH_AUTOSIZE, wxALIGN_LEFT, wxCOL_RESIZABLE );
-    m_stateTree->AppendColumn( "Value", wxCOL_WIDTH_AUTOSIZE, wxALIGN_LEFT, wxCOL_RESIZABLE );
-
-    wxImageList* images = new wxImageList(16, 16);
-    images->Add(wxArtProvider::GetBitmap(wxART_FOLDER, wxART_OTHER, wxSize(16,16)));
-    images->Add(wxArtProvider::GetBitmap(wxART_NORMAL_FILE, wxART_OTHER, wxSize(16,16)));
-    m_stateTree->SetImageList(images);
+    m_output = new geOutputView( this, wxID_ANY, wxSize( -1, 120 ) );
+
+    // State tree (left pane), with a filter box above it
+    m_statePanel = new wxPanel( this );
+    m_stateFilter = new wxSearchCtrl( m_statePanel, wxID_ANY );
+    m_stateFilter->SetDescriptiveText( "Filter names and values" );
+    m_stateFilter->ShowCancelButton( true );
+    m_stateFilter->Bind( wxEVT_TEXT, &geMainFrame::OnStateFilter, this );
+    m_stateFilter->Bind( wxEVT_SEARCHCTRL_CANCEL_BTN, &geMainFrame::OnStateFilterCancel, this );
+    m_stateTree = new geStateView( m_statePanel, wxID_ANY, wxSize( 250, -1 ) );
+    m_stateTree->SetValueFunc( [this]( const geStateRowKey& key, geStateView::ReplyFunc reply ) {
+        FindStateValue( key, std::move( reply ) );
+    } );
+    wxBoxSizer* stateSizer = new wxBoxSizer( wxVERTICAL );
+    stateSizer->Add( m_stateFilter, 0, wxEXPAND | wxBOTTOM, 2 );
+    stateSizer->Add( m_stateTree, 1, wxEXPAND );
+    m_statePanel->SetSizer( stateSizer );
+
+    // Run history (bottom pane, beside the output)
+    m_runHistory = new geRunHistory( this, wxID_ANY, wxSize( -1, 120 ) );
+
+    // Profile (bottom pane, shown after a profiled run)
+    m_profileView = new geProfileView( this, wxID_ANY, wxSize( -1, 120 ) );
+    m_profileView->Bind( wxEVT_LIST_ITEM_ACTIVATED, &geMainFrame::OnProfileActivated, this );
 
     m_mgr.AddPane( m_notebook, wxAuiPaneInfo().CenterPane().PaneBorder( false ) );
     m_mgr.AddPane( m_output, wxAuiPaneInfo().Bottom().Caption( "Output" ).BestSize( -1, 120 ).MinSize( -1, 60 ).Resizable( true ).CloseButton( false ) );
-    m_mgr.AddPane( m_stateTree, wxAuiPaneInfo().Left().Caption( "Glich State" ).BestSize( 250, -1 ).MinSize( 150, -1 ).Resizable( true ).CloseButton( false ) );
+    m_mgr.AddPane( m_runHistory, wxAuiPaneInfo().Bottom().Position( 1 ).Caption( "Run History" ).BestSize( 400, 120 ).MinSize( -1, 60 ).Resizable( true ).CloseButton( false ) );
+    m_mgr.AddPane( m_profileView, wxAuiPaneInfo().Bottom().Position( 2 ).Name( "Profile" ).Caption( "Profile" ).BestSize( 400, 120 ).MinSize( -1, 60 ).Resizable( true ).Hide() );
+    m_mgr.AddPane( m_statePanel, wxAuiPaneInfo().Left().Caption( "Glich State" ).BestSize( 250, -1 ).MinSize( 150, -1 ).Resizable( true ).CloseButton( false ) );
     m_mgr.Update();
 
+    m_outputTimer.Bind( wxEVT_TIMER, &geMainFrame::OnOutputTimer, this );
+    m_watchTimer.Bind( wxEVT_TIMER, &geMainFrame::OnWatchTimer, this );
+    m_sessionTimer.Bind( wxEVT_TIMER, &geMainFrame::OnSessionTimer, this );
+
+    // Sessions are run by gliched_run, installed beside gliched. Without it
+    // all scripts are run by the interpreter in this process.
+    wxFileName sessionExe( wxStandardPaths::Get().GetExecutablePath() );
+    sessionExe.SetName( "gliched_run" );
+    if( sessionExe.FileExists() ) {
+        m_sessions.SetCommand( "\"" + sessionExe.GetFullPath() + "\" --session --lib " + library );
+        if( m_sessionsEnabled ) {
+            m_sessions.Prepare();
+            PollSessions();
+        }
+    }
+
+    wxFileName cacheDir = wxFileName::DirName( wxStandardPaths::Get().GetUserDir( wxStandardPaths::Dir_Cache ) );
+    cacheDir.AppendDir( "gliched" );
+    cacheDir.AppendDir( "runs" );
+    m_runCache = std::make_unique<geRunCache>( cacheDir.GetPath().utf8_string(), RUN_CACHE_BYTES );
+
     UpdateStateTree();
 
     // Add initial tab
@@ -207,6 +314,9 @@ geMainFrame::geMainFrame( const wxString& filename )
 
 geMainFrame::~geMainFrame()
 {
+    // A run that is still going must not write to the output buffer or call
+    // back into the frame once they are gone.
+    m_runner.Abandon();
     m_mgr.UnInit();
 }
 
@@ -326,6 +436,37 @@ void geMainFrame::OnPaste( wxCommandEvent& )
     if( editor ) editor->Paste();
 }
 
+void geMainFrame::OnFindOutput( wxCommandEvent& evt )
+{
+    wxString text = wxGetTextFromUser( "Find text in the output:", "Find in Output", m_outputFind, this );
+    if( text.IsEmpty() ) return;
+    m_outputFind = text;
+    OnFindNextOutput( evt );
+}
+
+void geMainFrame::OnFindNextOutput( wxCommandEvent& evt )
+{
+    if( m_outputFind.IsEmpty() ) {
+        OnFindOutput( evt );
+        return;
+    }
+    if( !m_output->FindNext( m_outputFind ) ) {
+        SetStatusText( "Not found in output: " + m_outputFind );
+    }
+}
+
+void geMainFrame::OnOutputLimit( wxCommandEvent& )
+{
+    const size_t mb = 1024 * 1024;
+    long limit = wxGetNumberFromUser(
+        "The oldest output lines are discarded when the output exceeds this size.",
+        "Size in MB:", "Output Limit",
+        static_cast<long>( m_output->GetCapacity() / mb ), 1, 4096, this );
+    if( limit > 0 ) {
+        m_output->SetCapacity( static_cast<size_t>( limit ) * mb );
+    }
+}
+
 void geMainFrame::OnHelpWebsite( wxCommandEvent& )
 {
     wxLaunchDefaultBrowser( "https://nickmat.github.io/gliched/index.htm" );
@@ -353,7 +494,7 @@ void geMainFrame::OnHelpAbout( wxCommandEvent& )
     );
 }
 
-void geMainFrame::OnRun( wxCommandEvent& )
+void geMainFrame::OnRun( wxCommandEvent& evt )
 {
     int sel = GetRunTab();
     if( sel == wxNOT_FOUND ) {
@@ -368,16 +509,385 @@ void geMainFrame::OnRun( wxCommandEvent& )
     }
     geEditor* editor = dynamic_cast<geEditor*>(m_notebook->GetPage( sel ));
     if( !editor ) return;
+    UpdateWatchedModules( editor );
+    if( UseSessions() ) {
+        RunInSession( editor, evt.GetId() == ID_Run_Profile );
+        return;
+    }
+    if( m_runner.IsRunning() || geRunner::IsActive() ) {
+        SetStatusText( "A script is already running" );
+        return;
+    }
 
-    std::string script = editor->GetText().mb_str( wxConvUTF8 );
-    std::string result = glich::hic().run_script( script, "module" );
-    m_output->SetValue( wxString::FromUTF8( result.c_str() ) );
-    UpdateStateTree();
+    // The interpreter is not used by the GUI thread during a run, so the
+    // module paths are passed on here rather than as files are opened.
+    glich::hic().set_file_module_paths( m_modulePaths );
+
+    // The script is copied once, as the editor can be changed while it runs,
+    // and then moved to the worker thread.
+    std::string script = editor->GetUtf8Text();
+    geRunner::Options options;
+    options.profile = evt.GetId() == ID_Run_Profile;
+
+    // A run is repeated from the cache if the script, the modules it could
+    // use, the interpreter version and the state it starts from are all
+    // unchanged.
+    m_runKey = geRunKey();
+    m_watchRun = false;
+    if( m_runCacheEnabled && !options.profile ) {
+        m_runKey = geRunCache::MakeKey( script, m_modulePaths, glich::hic().version(), m_stateHash );
+        std::string output;
+        if( m_runKey.id != 0 && m_runCache->Find( m_runKey, output ) ) {
+            ShowCachedRun( editor, output );
+            return;
+        }
+        options.keepOutput = RUN_CACHE_BYTES / 4;
+    }
+
+    m_outputBuffer.Clear();
+    bool started = m_runner.Start( std::move( script ), "module", options, &m_outputBuffer,
+        [this]( const geRunStats& stats ) {
+            CallAfter( [this, stats]() { OnRunDone( stats ); } );
+        }
+    );
+    if( started ) {
+        m_runName = editor->GetTabName();
+        m_runEditor = editor;
+        m_profiling = options.profile;
+        m_shownSession = nullptr;
+        editor->ClearHeatMap();
+        m_output->Clear();
+        m_outputTimer.Start( OUTPUT_FLUSH_MS );
+        SetStatusText( "Running: " + m_runName + "..." );
+    }
+}
+
+void geMainFrame::OnStop( wxCommandEvent& )
+{
+    CancelRun();
+}
+
+void geMainFrame::OnUpdateRun( wxUpdateUIEvent& evt )
+{
+    if( !UseSessions() ) {
+        evt.Enable( !m_runner.IsRunning() );
+        return;
+    }
+    geSession* session = GetRunSession();
+    evt.Enable( !session || !session->IsBusy() );
+}
+
+void geMainFrame::OnUpdateStop( wxUpdateUIEvent& evt )
+{
+    evt.Enable( IsRunBusy() );
+}
+
+geEditor* geMainFrame::GetRunEditor() const
+{
+    int sel = GetRunTab();
+    return sel == wxNOT_FOUND ? nullptr : dynamic_cast<geEditor*>( m_notebook->GetPage( sel ) );
+}
+
+geSession* geMainFrame::GetRunSession() const
+{
+    geEditor* editor = GetRunEditor();
+    return editor ? m_sessions.Find( editor ) : nullptr;
+}
+
+// True if the run file is running, in its session or in this process.
+bool geMainFrame::IsRunBusy() const
+{
+    geSession* session = GetRunSession();
+    return m_runner.IsRunning() || ( session && session->IsBusy() );
+}
+
+// True if the run of the run file has been cancelled, but is still busy.
+bool geMainFrame::IsRunCancelled() const
+{
+    geSession* session = GetRunSession();
+    if( session && session->IsBusy() ) {
+        return session->IsCancelled();
+    }
+    return m_runner.IsRunning() && geRunner::IsCancelRequested();
+}
+
+void geMainFrame::CancelRun()
+{
+    geSession* session = GetRunSession();
+    if( session && session->IsBusy() ) {
+        if( session->Cancel() ) {
+            SetStatusText( "Stopping: " + session->GetName() + ", its session state will be reset..." );
+        }
+        else {
+            SetStatusText( "Could not stop the session running " + session->GetName() );
+        }
+    }
+    else if( m_runner.IsRunning() ) {
+        m_runner.Cancel();
+        SetStatusText( "Stopping: " + m_runName + "..." );
+    }
+}
+
+void geMainFrame::RunInSession( geEditor* editor, bool profile )
+{
+    geSession* session = m_sessions.Find( editor );
+    if( session && session->IsBusy() ) {
+        SetStatusText( "A script is already running in this tab" );
+        return;
+    }
+    if( session && m_freshRuns ) {
+        // Swap in a session that has only loaded the library.
+        bool shown = session == m_shownSession;
+        session = m_sessions.Reset( editor );
+        if( shown ) {
+            m_shownSession = session;
+        }
+    }
+    else {
+        session = m_sessions.Get( editor );
+    }
+    if( !session ) {
+        SetStatusText( "Every session is busy" );
+        return;
+    }
+    std::string script = editor->GetUtf8Text();
+    m_watchRun = false;
+    geRunKey key;
+    if( m_runCacheEnabled && !profile ) {
+        key = geRunCache::MakeKey( script, m_modulePaths, glich::hic().version(), session->GetStateHash() );
+        std::string output;
+        if( key.id != 0 && m_runCache->Find( key, output ) ) {
+            m_shownSession = nullptr;
+            ShowCachedRun( editor, output );
+            return;
+        }
+    }
+    session->SetName( editor->GetTabName() );
+    session->SetRunKey( std::move( key ) );
+    if( !session->Run( script, m_modulePaths, profile ) ) {
+        SetStatusText( "Unable to start a session" );
+        return;
+    }
+    editor->ClearHeatMap();
+    m_shownSession = session;
+    m_output->Clear();
+    PollSessions();
+    SetStatusText( "Running: " + session->GetName() + "..." );
+}
+
+// Show a profile in the Profile pane, and as a heat map in the margin of
+// the editor it was run from, if that is still open.
+void geMainFrame::ShowProfile( const geProfile& profile, geEditor* editor )
+{
+    m_profileView->SetProfile( profile );
+    m_mgr.GetPane( m_profileView ).Show();
+    m_mgr.Update();
+    if( editor && m_notebook->GetPageIndex( editor ) != wxNOT_FOUND ) {
+        editor->SetHeatMap( profile );
+    }
+}
+
+// The editor whose tab owns session, or nullptr if it has been closed.
+geEditor* geMainFrame::FindSessionEditor( const geSession* session ) const
+{
+    for( size_t i = 0; i < m_notebook->GetPageCount(); ++i ) {
+        geEditor* editor = dynamic_cast<geEditor*>( m_notebook->GetPage( i ) );
+        if( editor && m_sessions.Find( editor ) == session ) {
+            return editor;
+        }
+    }
+    return nullptr;
+}
+
+// The pool is about to destroy session, which may be the one shown.
+void geMainFrame::OnSessionClosed( geSession* session )
+{
+    if( session == m_shownSession ) {
+        m_shownSession = nullptr;
+    }
+}
+
+// Show the output and state of a session's last run.
+void geMainFrame::ShowSession( geSession* session )
+{
+    m_shownSession = session;
+    m_output->Clear();
+    m_output->AppendText( session->GetOutput() );
+    ShowState( session->GetState() );
+}
+
+void geMainFrame::OnSessionDone( geSession* session, const geRunStats& stats )
+{
+    m_runHistory->AddRun( session->GetName(), stats );
+    SetStatusText( geRunHistory::Summary( session->GetName(), stats ) );
+    if( session == m_shownSession ) {
+        ShowSession( session );
+    }
+    if( session->IsProfiling() ) {
+        ShowProfile( session->GetProfile(), FindSessionEditor( session ) );
+    }
+    const std::string& output = session->GetOutput();
+    if( session->GetRunKey().id != 0 && !stats.cancelled && !stats.interactive
+        && session->GetStateHash() == session->GetStartStateHash() )
+    {
+        m_runCache->Store( session->GetRunKey(), output );
+    }
+    if( m_watchPending ) {
+        m_watchPending = false;
+        m_watchTimer.StartOnce( WATCH_DELAY_MS );
+    }
+}
+
+void geMainFrame::OnSessionTimer( wxTimerEvent& )
+{
+    m_sessions.Poll();
+    if( !m_sessions.NeedsPolling() ) {
+        m_sessionTimer.Stop();
+    }
+}
+
+// Make sure the sessions are polled while any are starting or running.
+void geMainFrame::PollSessions()
+{
+    if( m_sessions.NeedsPolling() && !m_sessionTimer.IsRunning() ) {
+        m_sessionTimer.Start( OUTPUT_FLUSH_MS );
+    }
+}
+
+// The prompt is shown after the sessions have been polled, as its dialog
+// runs an event loop in which sessions may be closed or replaced. So the
+// session is looked up again, both before and after the dialog.
+void geMainFrame::AskSessionInput( geSession* session, const std::string& prompt )
+{
+    uint64_t id = session->GetId();
+    CallAfter( [this, id, prompt]() {
+        geSession* waiting = m_sessions.FindById( id );
+        if( !waiting || !waiting->IsWaitingForInput() ) {
+            return;
+        }
+        std::string answer = PromptInput( prompt );
+        waiting = m_sessions.FindById( id );
+        if( waiting ) {
+            waiting->Answer( answer );
+        }
+    } );
+}
+
+std::string geMainFrame::PromptInput( const std::string& prompt )
+{
+    wxTextEntryDialog dialog( this, wxString::FromUTF8( prompt ), _( "Gliched Input" ), "", wxOK | wxCANCEL );
+    if( dialog.ShowModal() == wxID_OK ) {
+        return dialog.GetValue().utf8_string();
+    }
+    return std::string();
+}
+
+void geMainFrame::OnRunDone( const geRunStats& stats )
+{
+    m_runner.Join();
+    if( stats.cancelled ) {
+        m_outputBuffer.Clear();
+    }
+    m_runHistory->AddRun( m_runName, stats );
+    SetStatusText( geRunHistory::Summary( m_runName, stats ) );
+    if( m_profiling ) {
+        ShowProfile( m_runner.GetProfile(), m_runEditor );
+    }
+    uint64_t stateBefore = m_stateHash;
+    m_stateHash = m_runner.GetStateHash();
+    ShowState( m_runner.GetState() );
+
+    // A cached result can't repeat changes a script makes to the state, so
+    // only runs that leave the state as they found it are stored. This is
+    // usually true from the second run of a script onwards.
+    const std::string& output = m_runner.GetOutput();
+    if( m_runKey.id != 0 && !stats.cancelled && !stats.interactive
+        && m_stateHash == stateBefore && output.size() == stats.outputBytes )
+    {
+        m_runCache->Store( m_runKey, output );
+    }
+    if( m_watchPending ) {
+        m_watchPending = false;
+        m_watchTimer.StartOnce( WATCH_DELAY_MS );
+    }
+}
+
+void geMainFrame::ShowCachedRun( geEditor* editor, const std::string& output )
+{
+    geRunStats stats;
+    stats.cached = true;
+    stats.CountOutput( output );
+    m_runName = editor->GetTabName();
+    editor->ClearHeatMap();
+    m_outputBuffer.Clear();
+    m_output->Clear();
+    // Say so in the output itself, as it may not be what a run gives now.
+    m_output->AppendText( "[Cached output of an earlier identical run. The script was not run.]\n" );
+    m_output->AppendText( output );
+    m_runHistory->AddRun( m_runName, stats );
+    SetStatusText( geRunHistory::Summary( m_runName, stats ) );
+}
+
+// Find the full value of a row of the shown state, which was cut short in
+// the snapshot. A session replies when it has been polled.
+void geMainFrame::FindStateValue( const geStateRowKey& key, geStateView::ReplyFunc reply )
+{
+    if( UseSessions() && m_shownSession ) {
+        if( m_shownSession->RequestValue( key, std::move( reply ) ) ) {
+            PollSessions();
+        }
+        return;
+    }
+    std::string value;
+    if( !geRunner::IsActive() && geState::FindValue( key, value ) ) {
+        reply( value );
+    }
+}
+
+// The State pane is filtered as each character is typed.
+void geMainFrame::OnStateFilter( wxCommandEvent& )
+{
+    m_stateTree->SetFilter( m_stateFilter->GetValue() );
+}
+
+void geMainFrame::OnStateFilterCancel( wxCommandEvent& )
+{
+    m_stateFilter->Clear(); // Sends wxEVT_TEXT.
+}
+
+// Go to the statement double clicked in the Profile pane.
+void geMainFrame::OnProfileActivated( wxListEvent& evt )
+{
+    int page = m_notebook->GetPageIndex( m_runEditor );
+    if( page == wxNOT_FOUND ) {
+        SetStatusText( "The profiled script is no longer open" );
+        return;
+    }
+    m_notebook->SetSelection( page );
+    m_runEditor->GotoLine( m_profileView->GetLine( evt.GetIndex() ) );
+    m_runEditor->SetFocus();
+}
+
+void geMainFrame::OnOutputTimer( wxTimerEvent& )
+{
+    std::string text = m_outputBuffer.Take( OUTPUT_FLUSH_BYTES );
+    if( !text.empty() ) {
+        m_output->AppendText( text );
+    }
+    if( !m_runner.IsRunning() && m_outputBuffer.IsEmpty() ) {
+        m_outputTimer.Stop();
+    }
 }
 
 void geMainFrame::OnTabChanged( wxAuiNotebookEvent& )
 {
     UpdateStatusBar();
+    int sel = m_notebook->GetSelection();
+    if( sel == wxNOT_FOUND || !UseSessions() ) return;
+    geSession* session = m_sessions.Find( dynamic_cast<geEditor*>( m_notebook->GetPage( sel ) ) );
+    if( session && session != m_shownSession && !session->IsBusy() ) {
+        ShowSession( session );
+    }
 }
 
 void geMainFrame::OnTabRightClick( wxAuiNotebookEvent& event )
@@ -425,6 +935,10 @@ void geMainFrame::OnTabClose( wxAuiNotebookEvent& evt )
                 return;
             }
         }
+        m_sessions.Release( editor );
+        if( editor == m_watchedEditor ) {
+            m_watchedEditor = nullptr;
+        }
     }
 }
 
@@ -457,6 +971,19 @@ void geMainFrame::OnClearRunFile( wxCommandEvent& )
 
 void geMainFrame::OnClose( wxCloseEvent& event )
 {
+    if( ( m_runner.IsRunning() || m_sessions.IsBusy() ) && event.CanVeto() ) {
+        int res = wxMessageBox(
+            "A script is still running. Do you want to exit anyway?",
+            "Script Running",
+            wxYES_NO | wxICON_WARNING,
+            this
+        );
+        if( res != wxYES ) {
+            event.Veto();
+            return;
+        }
+        m_runner.Cancel();
+    }
     for( size_t i = 0; i < m_notebook->GetPageCount(); ++i ) {
         geEditor* editor = dynamic_cast<geEditor*>( m_notebook->GetPage( i ) );
         if( editor && editor->IsModified() ) {
@@ -486,6 +1013,142 @@ void geMainFrame::OnToggleAutosave( wxCommandEvent& evt )
     m_autosaveEnabled = evt.IsChecked();
 }
 
+void geMainFrame::OnToggleRunCache( wxCommandEvent& evt )
+{
+    m_runCacheEnabled = evt.IsChecked();
+}
+
+void geMainFrame::OnClearRunCache( wxCommandEvent& )
+{
+    m_runCache->Clear();
+    SetStatusText( "Result cache cleared" );
+}
+
+void geMainFrame::OnToggleSessions( wxCommandEvent& evt )
+{
+    m_sessionsEnabled = evt.IsChecked();
+    if( m_sessionsEnabled && !m_sessions.IsAvailable() ) {
+        SetStatusText( "Sessions need gliched_run, which was not found beside gliched" );
+    }
+}
+
+void geMainFrame::OnToggleFreshRuns( wxCommandEvent& evt )
+{
+    m_freshRuns = evt.IsChecked();
+}
+
+// Sessions are reset by swapping in the spare session, which has already
+// loaded the library. Without sessions the interpreter in this process is
+// restarted, which loads the library again.
+void geMainFrame::OnResetState( wxCommandEvent& )
+{
+    geEditor* editor = GetRunEditor();
+    if( IsRunBusy() || !editor ) {
+        SetStatusText( "The state can't be reset while a script is running" );
+        return;
+    }
+    if( UseSessions() ) {
+        geSession* old = m_sessions.Find( editor );
+        bool shown = old && old == m_shownSession;
+        geSession* session = m_sessions.Reset( editor );
+        if( session && shown ) {
+            m_shownSession = session;
+            ShowState( session->GetState() );
+        }
+        PollSessions();
+        SetStatusText( "Session state reset: " + editor->GetTabName() );
+        return;
+    }
+    if( !wxGetApp().ResetInterpreter() ) {
+        SetStatusText( "The interpreter is still in use by a stopped script" );
+        return;
+    }
+    UpdateStateTree();
+    SetStatusText( "Interpreter state reset" );
+}
+
+void geMainFrame::OnToggleWatch( wxCommandEvent& evt )
+{
+    m_watchEnabled = evt.IsChecked();
+    if( !m_watchEnabled ) {
+        m_watchTimer.Stop();
+        m_watchPending = false;
+        m_watchedEditor = nullptr;
+        m_watchedModules.clear();
+    }
+    else if( GetRunEditor() ) {
+        UpdateWatchedModules( GetRunEditor() );
+    }
+}
+
+// True if editor is the run file, or a file that the run file's last run
+// could have used as a module.
+bool geMainFrame::IsWatched( geEditor* editor )
+{
+    int sel = GetRunTab();
+    if( sel == wxNOT_FOUND ) return false;
+    geEditor* runEditor = dynamic_cast<geEditor*>( m_notebook->GetPage( sel ) );
+    if( !runEditor ) return false;
+    if( editor == runEditor ) return true;
+    if( editor->GetFilename().IsEmpty() || runEditor != m_watchedEditor ) return false;
+
+    wxFileName filename( editor->GetFilename() );
+    for( const wxFileName& module : m_watchedModules ) {
+        if( filename.SameAs( module ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Finding the modules scans the module directories, so it is done once as
+// each run starts, rather than on every save or keystroke.
+void geMainFrame::UpdateWatchedModules( geEditor* runEditor )
+{
+    m_watchedEditor = runEditor;
+    m_watchedModules.clear();
+    if( !m_watchEnabled ) {
+        return;
+    }
+    for( const geModuleFile& module : geFindModules( runEditor->GetUtf8Text(), m_modulePaths ) ) {
+        m_watchedModules.emplace_back( wxString::FromUTF8( module.path ) );
+    }
+}
+
+// An edit makes the output of a run started by watch mode out of date. The
+// interpreter can't be interrupted, but its output is dropped and the next
+// save starts a new run as soon as it finishes.
+void geMainFrame::EditorChanged( geEditor* editor )
+{
+    if( m_watchEnabled && m_watchRun && IsRunBusy()
+        && !IsRunCancelled() && IsWatched( editor ) )
+    {
+        CancelRun();
+    }
+}
+
+void geMainFrame::EditorSaved( geEditor* editor )
+{
+    if( m_watchEnabled && IsWatched( editor ) ) {
+        m_watchTimer.StartOnce( WATCH_DELAY_MS );
+    }
+}
+
+void geMainFrame::OnWatchTimer( wxTimerEvent& )
+{
+    if( IsRunBusy() || ( !UseSessions() && geRunner::IsActive() ) ) {
+        if( m_watchRun ) {
+            CancelRun();
+        }
+        m_watchPending = true;
+        return;
+    }
+    if( GetRunTab() == wxNOT_FOUND ) return;
+    wxCommandEvent evt( wxEVT_MENU, ID_Run );
+    OnRun( evt );
+    m_watchRun = IsRunBusy();
+}
+
 wxString geMainFrame::GetFilePathForTab( int idx ) const
 {
     geEditor* editor = dynamic_cast<geEditor*>( m_notebook->GetPage( idx ) );
@@ -537,70 +1200,18 @@ void geMainFrame::UpdateTabIndicators()
     }
 }
 
+// Show the state of the interpreter in this process, when no script is
+// running. Runs capture the state on their worker thread.
 void geMainFrame::UpdateStateTree()
 {
-    m_stateTree->DeleteAllItems();
-
-    glich::HicMarkDataVec state = glich::hic().get_hic_data();
-
-    wxTreeListItem root = m_stateTree->GetRootItem();
-    if( !root.IsOk() )
-        root = m_stateTree->AppendItem( m_stateTree->GetRootItem(), "Glich State" );
+    geStatePtr state = std::make_shared<const geState>( geState::Capture() );
+    m_stateHash = state->Hash();
+    ShowState( state );
+}
 
-    for( const auto& mark : state )
-    {
-        const char* type = mark.glc.name.empty() ? "root" : "mark";
-        wxTreeListItem markItem = m_stateTree->InsertItem( root, wxTLI_LAST, type );
-        m_stateTree->SetItemText( markItem, 1, mark.glc.name );
-
-        auto addDataList = [&]( const std::string& label, const auto& list ) {
-            if( !list.empty() ) {
-                wxTreeListItem cat = m_stateTree->AppendItem( markItem, label );
-                for( const auto& data : list ) {
-                    wxTreeListItem item = m_stateTree->AppendItem( cat, "" );
-                    m_stateTree->SetItemText( item, 0, wxString::FromUTF8( data.name.c_str() ) );
-                    m_stateTree->SetItemText( item, 1, wxString::FromUTF8( data.value.c_str() ) );
-                }
-            }
-        };
-
-        addDataList( "object", mark.glc.obj );
-        addDataList( "file", mark.glc.file );
-        addDataList( "function", mark.glc.fun );
-        addDataList( "command", mark.glc.com );
-        addDataList( "lexicon", mark.lex );
-        addDataList( "grammar", mark.gmr );
-        addDataList( "format", mark.fmt );
-        addDataList( "scheme", mark.sch );
-
-        if( !mark.glc.var.empty() ) {
-            wxTreeListItem cat = m_stateTree->AppendItem( markItem, "variables" );
-            for( const auto& data : mark.glc.var ) {
-                wxTreeListItem item = m_stateTree->AppendItem( cat, "" );
-                m_stateTree->SetItemText( item, 0, wxString::FromUTF8( data.type.c_str() ) );
-                m_stateTree->SetItemText( item, 1, wxString::FromUTF8( data.name.c_str() ) );
-                m_stateTree->SetItemText( item, 2, wxString::FromUTF8( data.value.c_str() ) );
-            }
-        }
-        if( !mark.glc.global.empty() ) {
-            wxTreeListItem cat = m_stateTree->AppendItem( markItem, "globals" );
-            for( const auto& data : mark.glc.global ) {
-                wxTreeListItem item = m_stateTree->AppendItem( cat, "" );
-                m_stateTree->SetItemText( item, 0, wxString::FromUTF8( data.type.c_str() ) );
-                m_stateTree->SetItemText( item, 1, wxString::FromUTF8( data.name.c_str() ) );
-                m_stateTree->SetItemText( item, 2, wxString::FromUTF8( data.value.c_str() ) );
-            }
-        }
-        if( !mark.glc.constant.empty() ) {
-            wxTreeListItem cat = m_stateTree->AppendItem( markItem, "constants" );
-            for( const auto& data : mark.glc.constant ) {
-                wxTreeListItem item = m_stateTree->AppendItem( cat, "" );
-                m_stateTree->SetItemText( item, 0, wxString::FromUTF8( data.type.c_str() ) );
-                m_stateTree->SetItemText( item, 1, wxString::FromUTF8( data.name.c_str() ) );
-                m_stateTree->SetItemText( item, 2, wxString::FromUTF8( data.value.c_str() ) );
-            }
-        }
-    }
+void geMainFrame::ShowState( geStatePtr state )
+{
+    m_stateTree->SetState( std::move( state ) );
 }
 
 void geMainFrame::UpdateStatusBar()
@@ -626,5 +1237,4 @@ void geMainFrame::AddModulePath( const std::string& path )
         if( p == path ) return;
     }
     m_modulePaths.push_back( path );
-    glich::hic().set_file_module_paths( m_modulePaths );
 }
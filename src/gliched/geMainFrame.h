@@ -31,26 +31,52 @@
 #include <wx/aui/auibook.h>
 #include <wx/toolbar.h>
 #include <wx/statusbr.h>
+#include <wx/panel.h>
 #include <wx/textctrl.h>
-#include <wx/treelist.h>
+#include <wx/srchctrl.h>
+#include <wx/timer.h>
+#include <wx/filename.h>
 
+#include "geOutputBuffer.h"
+#include "geOutputView.h"
+#include "geProfileView.h"
+#include "geRunCache.h"
+#include "geRunHistory.h"
+#include "geRunner.h"
+#include "geSessionPool.h"
+#include "geState.h"
+#include "geStateView.h"
+
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 
+class geEditor;
+
 class geMainFrame : public wxFrame
 {
 public:
-    geMainFrame( const wxString& filename = wxEmptyString );
+    // library is the Glich library loaded by sessions, "hics" or "none".
+    geMainFrame( const wxString& filename = wxEmptyString, const wxString& library = "hics" );
     ~geMainFrame();
 
     bool IsAutosaveEnabled() const { return m_autosaveEnabled; }
 
+    // Called by the editors, for watch mode.
+    void EditorChanged( geEditor* editor );
+    void EditorSaved( geEditor* editor );
+
 private:
     wxAuiManager m_mgr;
     wxAuiNotebook* m_notebook;
     wxToolBar* m_toolbar;
-    wxTextCtrl* m_output;
-    wxTreeListCtrl* m_stateTree;
+    geOutputView* m_output;
+    wxPanel* m_statePanel;
+    wxSearchCtrl* m_stateFilter;
+    geStateView* m_stateTree;
+    geRunHistory* m_runHistory;
+    geProfileView* m_profileView;
 
     void OnNew(wxCommandEvent& evt);
     void OnOpen(wxCommandEvent& evt);
@@ -62,9 +88,15 @@ private:
     void OnCut( wxCommandEvent& evt );
     void OnCopy( wxCommandEvent& evt );
     void OnPaste( wxCommandEvent& evt );
+    void OnFindOutput( wxCommandEvent& evt );
+    void OnFindNextOutput( wxCommandEvent& evt );
+    void OnOutputLimit( wxCommandEvent& evt );
     void OnHelpWebsite( wxCommandEvent& evt );
     void OnHelpAbout( wxCommandEvent& evt );
     void OnRun( wxCommandEvent& evt );
+    void OnStop( wxCommandEvent& evt );
+    void OnUpdateRun( wxUpdateUIEvent& evt );
+    void OnUpdateStop( wxUpdateUIEvent& evt );
     void OnTabChanged(wxAuiNotebookEvent& evt);
     void OnTabRightClick( wxAuiNotebookEvent& evt );
     void OnTabClose( wxAuiNotebookEvent& evt );
@@ -72,21 +104,76 @@ private:
     void OnClearRunFile( wxCommandEvent& evt );
     void OnClose( wxCloseEvent& event );
     void OnToggleAutosave( wxCommandEvent& );
+    void OnToggleRunCache( wxCommandEvent& evt );
+    void OnClearRunCache( wxCommandEvent& evt );
+    void OnToggleWatch( wxCommandEvent& evt );
+    void OnToggleSessions( wxCommandEvent& evt );
+    void OnToggleFreshRuns( wxCommandEvent& evt );
+    void OnResetState( wxCommandEvent& evt );
+    void OnWatchTimer( wxTimerEvent& evt );
 
     wxString GetFilePathForTab( int idx ) const;
     bool IsTabSetAsRunFile( int idx ) const;
     wxString GetTabLabelForFile( const wxString& filePath ) const;
 
     int GetRunTab() const;
+    bool IsWatched( geEditor* editor );
+    void UpdateWatchedModules( geEditor* runEditor );
     void UpdateTabIndicators();
     void UpdateStateTree();
+    void ShowState( geStatePtr state );
     void UpdateStatusBar();
     void AddModulePath( const std::string& path );
+    void OnRunDone( const geRunStats& stats );
+    void ShowCachedRun( geEditor* editor, const std::string& output );
+    bool UseSessions() const { return m_sessionsEnabled && m_sessions.IsAvailable(); }
+    geEditor* GetRunEditor() const;
+    geSession* GetRunSession() const;
+    bool IsRunBusy() const;
+    bool IsRunCancelled() const;
+    void CancelRun();
+    void RunInSession( geEditor* editor, bool profile );
+    void ShowSession( geSession* session );
+    void ShowProfile( const geProfile& profile, geEditor* editor );
+    geEditor* FindSessionEditor( const geSession* session ) const;
+    void OnSessionDone( geSession* session, const geRunStats& stats );
+    void OnSessionClosed( geSession* session );
+    void OnSessionTimer( wxTimerEvent& evt );
+    void PollSessions();
+    void AskSessionInput( geSession* session, const std::string& prompt );
+    std::string PromptInput( const std::string& prompt );
+    void OnOutputTimer( wxTimerEvent& evt );
+    void OnProfileActivated( wxListEvent& evt );
+    void FindStateValue( const geStateRowKey& key, geStateView::ReplyFunc reply );
+    void OnStateFilter( wxCommandEvent& evt );
+    void OnStateFilterCancel( wxCommandEvent& evt );
 
     int m_tabContextIndex; // Index of the tab for which the context menu is currently open, or -1 if none
     int m_newTabCounter; // Counter for naming new tabs
     std::vector<std::string> m_modulePaths; // File paths of each open file used for locating modules.
     bool m_autosaveEnabled = true;
+    geRunner m_runner;
+    geOutputBuffer m_outputBuffer;
+    wxTimer m_outputTimer; // Moves text from m_outputBuffer to m_output.
+    wxString m_outputFind; // Last text searched for in the output.
+    wxString m_runName; // Tab name of the script being run.
+    geEditor* m_runEditor = nullptr; // Editor of the script being run, which may since have been closed.
+    bool m_profiling = false; // The current run is being profiled.
+    std::unique_ptr<geRunCache> m_runCache;
+    bool m_runCacheEnabled = true;
+    geRunKey m_runKey; // Cache key of the current run, with id 0 if it is not to be cached.
+    uint64_t m_stateHash = 0; // Hash of the interpreter state shown in the state tree.
+    bool m_watchEnabled = false; // Re-run when the run file or its modules are saved.
+    bool m_watchRun = false; // The current run was started by watch mode.
+    bool m_watchPending = false; // Re-run when the current run is done.
+    wxTimer m_watchTimer;
+    geEditor* m_watchedEditor = nullptr; // Run file that m_watchedModules was found for.
+    std::vector<wxFileName> m_watchedModules; // Modules its last run could use.
+    geSessionPool m_sessions; // A separate interpreter process for each tab.
+    bool m_sessionsEnabled = true;
+    bool m_freshRuns = false; // Start each session run from the library's state.
+    geSession* m_shownSession = nullptr; // Session shown in the output and state panes, if any.
+    wxTimer m_sessionTimer; // Polls the sessions while any are busy.
 
     wxDECLARE_EVENT_TABLE();
 };
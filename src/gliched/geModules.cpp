@@ -0,0 +1,164 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geModules.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Find the module files a script may use.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "geModules.h"
+
+#include <gltok/gltok.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    // The .glcs files of each module path, keyed by their lower cased names
+    // so that a module is found on any file system. Names that differ only
+    // in case are all kept, as on a case sensitive file system either file
+    // could be the one used.
+    using Listing = std::multimap<std::string, fs::path>;
+
+    std::string LowerAscii( std::string text )
+    {
+        for( char& ch : text ) {
+            if( ch >= 'A' && ch <= 'Z' ) {
+                ch += 'a' - 'A';
+            }
+        }
+        return text;
+    }
+
+    Listing ListModules( const std::string& dir )
+    {
+        Listing listing;
+        std::error_code ec;
+        for( const fs::directory_entry& entry : fs::directory_iterator( fs::u8path( dir ), ec ) ) {
+            if( entry.path().extension() == ".glcs" && entry.is_regular_file( ec ) ) {
+                listing.emplace( LowerAscii( entry.path().filename().u8string() ), entry.path() );
+            }
+        }
+        return listing;
+    }
+
+    void AddModules(
+        std::string_view script, const std::vector<std::string>& modulePaths,
+        const std::vector<Listing>& listings, std::set<fs::path>& found, std::vector<geModuleFile>& modules )
+    {
+        std::vector<std::string> names;
+        gltok::Tokenizer tokenizer( script );
+        gltok::Token token;
+        while( tokenizer.next( token ) ) {
+            std::string_view text = script.substr( token.start, token.length );
+            if( token.kind == gltok::TokenKind::Identifier ) {
+                size_t pos = 0;
+                for( size_t colon = text.find( ':' ); ; colon = text.find( ':', pos ) ) {
+                    std::string_view part = text.substr( pos, colon == text.npos ? text.npos : colon - pos );
+                    if( !part.empty() ) {
+                        names.emplace_back( part );
+                    }
+                    if( colon == text.npos ) break;
+                    pos = colon + 1;
+                }
+            }
+            else if( token.kind == gltok::TokenKind::String && text.size() > 2 ) {
+                names.emplace_back( text.substr( 1, text.size() - 2 ) );
+            }
+        }
+        std::sort( names.begin(), names.end() );
+        names.erase( std::unique( names.begin(), names.end() ), names.end() );
+
+        for( const std::string& name : names ) {
+            fs::path file = fs::u8path( name );
+            if( file.extension() != ".glcs" ) {
+                file += ".glcs";
+            }
+            // Plain names are looked up in the listings. Only names with a
+            // directory part need the file system.
+            bool plain = name.find_first_of( "/\\" ) == std::string::npos;
+            std::string key = LowerAscii( file.u8string() );
+            for( size_t i = 0; i < modulePaths.size(); i++ ) {
+                std::vector<fs::path> paths;
+                if( plain ) {
+                    auto range = listings[i].equal_range( key );
+                    for( auto it = range.first; it != range.second; ++it ) {
+                        paths.push_back( it->second );
+                    }
+                }
+                else {
+                    fs::path path = fs::u8path( modulePaths[i] ) / file;
+                    std::error_code ec;
+                    if( fs::is_regular_file( path, ec ) ) {
+                        paths.push_back( path );
+                    }
+                }
+                for( const fs::path& path : paths ) {
+                    if( !found.insert( path ).second ) {
+                        continue;
+                    }
+                    std::ifstream in( path, std::ios::binary );
+                    std::ostringstream text;
+                    text << in.rdbuf();
+                    std::string module = text.str();
+                    modules.push_back( { path.u8string(), module } );
+                    AddModules( module, modulePaths, listings, found, modules );
+                }
+            }
+        }
+    }
+
+}
+
+std::vector<geModuleFile> geFindModules(
+    std::string_view script, const std::vector<std::string>& modulePaths )
+{
+    std::vector<Listing> listings;
+    for( const std::string& dir : modulePaths ) {
+        listings.push_back( ListModules( dir ) );
+    }
+    std::vector<geModuleFile> modules;
+    std::set<fs::path> found;
+    AddModules( script, modulePaths, listings, found, modules );
+    return modules;
+}
+
+bool geUsesOutsideData( std::string_view script )
+{
+    gltok::Tokenizer tokenizer( script );
+    gltok::Token token;
+    while( tokenizer.next( token ) ) {
+        if( token.kind == gltok::TokenKind::Keyword ) {
+            std::string_view word = script.substr( token.start, token.length );
+            if( word == "today" || word == "file" ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,50 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geModules.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Find the module files a script may use header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct geModuleFile
+{
+    std::string path;   // UTF-8.
+    std::string text;
+};
+
+// Find every file in modulePaths that script could use as a module, directly
+// or through another module. Module names are not known until the script
+// runs, so any identifier part or string that names a .glcs file in one of
+// the paths is taken as one. The result may include files that are not
+// used, but not miss any that are. Each path is listed once, rather than
+// looking for every name in every path.
+std::vector<geModuleFile> geFindModules(
+    std::string_view script, const std::vector<std::string>& modulePaths );
+
+// True if script uses the date (today) or reads or writes files (file),
+// which make its output depend on more than its text and modules.
+bool geUsesOutsideData( std::string_view script );
@@ -0,0 +1,83 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geOutputBuffer.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Thread safe buffer for script output, class source.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "geOutputBuffer.h"
+
+void geOutputBuffer::Append( std::string_view text )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_pending.append( text );
+}
+
+void geOutputBuffer::Append( std::string&& text )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    if( m_readPos == m_pending.size() ) {
+        // Nothing is waiting, so take the string over rather than copy it.
+        m_pending = std::move( text );
+        m_readPos = 0;
+        return;
+    }
+    m_pending.append( text );
+}
+
+std::string geOutputBuffer::Take( size_t maxBytes )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    size_t available = m_pending.size() - m_readPos;
+    if( available <= maxBytes ) {
+        std::string text = m_pending.substr( m_readPos );
+        m_pending.clear();
+        m_readPos = 0;
+        return text;
+    }
+    // Back up to the start of a UTF-8 sequence.
+    size_t end = m_readPos + maxBytes;
+    while( end > m_readPos && (static_cast<unsigned char>( m_pending[end] ) & 0xC0) == 0x80 ) {
+        --end;
+    }
+    std::string text = m_pending.substr( m_readPos, end - m_readPos );
+    m_readPos = end;
+    if( m_readPos > m_pending.size() / 2 ) {
+        // Drop the text already taken once it is the larger part.
+        m_pending.erase( 0, m_readPos );
+        m_readPos = 0;
+    }
+    return text;
+}
+
+bool geOutputBuffer::IsEmpty() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    return m_readPos == m_pending.size();
+}
+
+void geOutputBuffer::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_pending.clear();
+    m_readPos = 0;
+}
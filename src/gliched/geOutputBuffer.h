@@ -0,0 +1,55 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geOutputBuffer.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Thread safe buffer for script output, class header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// Collects UTF-8 output written by a running script on any thread, for the
+// GUI thread to take in batches on a timer. Writers only ever append to
+// the pending text, so many small writes cost one widget update per batch.
+class geOutputBuffer
+{
+public:
+    geOutputBuffer() : m_readPos( 0 ) {}
+
+    void Append( std::string_view text );
+    void Append( std::string&& text );
+
+    // Remove and return up to maxBytes of the pending text, never splitting
+    // a UTF-8 sequence.
+    std::string Take( size_t maxBytes );
+
+    bool IsEmpty() const;
+    void Clear();
+
+private:
+    mutable std::mutex m_mutex;
+    std::string m_pending;
+    size_t m_readPos;  // Start of the text not yet taken.
+};
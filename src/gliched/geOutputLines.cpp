@@ -0,0 +1,115 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geOutputLines.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Capped line store for script output, class source.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "geOutputLines.h"
+
+#include <algorithm>
+
+geOutputLines::geOutputLines( size_t capacity )
+    : m_capacity( capacity ), m_base( 0 ), m_dropped( 0 )
+{
+    m_starts.push_back( 0 );
+}
+
+void geOutputLines::SetCapacity( size_t capacity )
+{
+    m_capacity = capacity;
+    Trim();
+}
+
+void geOutputLines::Append( std::string_view text )
+{
+    size_t offset = m_base + m_text.size();
+    m_text.append( text );
+    for( size_t pos = text.find( '\n' ); pos != std::string_view::npos; pos = text.find( '\n', pos + 1 ) ) {
+        m_starts.push_back( offset + pos + 1 );
+    }
+    Trim();
+}
+
+void geOutputLines::Clear()
+{
+    m_text.clear();
+    m_starts.clear();
+    m_starts.push_back( 0 );
+    m_base = 0;
+    m_dropped = 0;
+}
+
+// The last line is only counted once it has some text.
+size_t geOutputLines::GetLineCount() const
+{
+    bool lastEmpty = (m_starts.back() == m_base + m_text.size());
+    return m_starts.size() - (lastEmpty ? 1 : 0);
+}
+
+std::string_view geOutputLines::GetLine( size_t line ) const
+{
+    size_t start = m_starts[line] - m_base;
+    size_t end = (line + 1 < m_starts.size()) ? m_starts[line + 1] - m_base - 1 : m_text.size();
+    if( end > start && m_text[end - 1] == '\r' ) {
+        --end;
+    }
+    return std::string_view( m_text.data() + start, end - start );
+}
+
+size_t geOutputLines::Find( std::string_view text, size_t fromLine ) const
+{
+    if( text.empty() || fromLine >= GetLineCount() ) {
+        return npos;
+    }
+    std::string_view all( m_text );
+    size_t first = m_starts.front() - m_base;
+    size_t from = m_starts[fromLine] - m_base;
+
+    size_t pos = all.find( text, from );
+    if( pos == std::string_view::npos ) {
+        pos = all.substr( 0, from + text.size() - 1 ).find( text, first );
+    }
+    return (pos == std::string_view::npos) ? npos : LineFromOffset( pos + m_base );
+}
+
+// Drop whole lines from the start until the text and its line offsets fit
+// the capacity, always keeping the last line. The dropped text is only removed from the buffer
+// once it is the larger part, so trimming is cheap on average.
+void geOutputLines::Trim()
+{
+    while( GetUsage() > m_capacity && m_starts.size() > 1 ) {
+        m_starts.pop_front();
+        ++m_dropped;
+    }
+    size_t unused = m_starts.front() - m_base;
+    if( unused > m_text.size() / 2 ) {
+        m_text.erase( 0, unused );
+        m_base = m_starts.front();
+    }
+}
+
+size_t geOutputLines::LineFromOffset( size_t offset ) const
+{
+    auto it = std::upper_bound( m_starts.begin(), m_starts.end(), offset );
+    return (it - m_starts.begin()) - 1;
+}
@@ -0,0 +1,72 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geOutputLines.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Capped line store for script output, class header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include <deque>
+#include <string>
+#include <string_view>
+
+// Holds output text as lines in one contiguous UTF-8 buffer with an offset
+// per line. When the text and the line offsets exceed the capacity the
+// oldest lines are dropped, so memory use stays bounded however much a
+// script writes, even if it writes many short lines.
+class geOutputLines
+{
+public:
+    explicit geOutputLines( size_t capacity );
+
+    void SetCapacity( size_t capacity );
+    size_t GetCapacity() const { return m_capacity; }
+
+    // Add text, which may start or end part way through a line.
+    void Append( std::string_view text );
+    void Clear();
+
+    size_t GetLineCount() const;
+    std::string_view GetLine( size_t line ) const;
+
+    // The number of lines dropped from the start since the last Clear.
+    size_t GetDroppedLineCount() const { return m_dropped; }
+    size_t GetByteCount() const { return m_text.size() - (m_starts.front() - m_base); }
+
+    // Find the first line at or after fromLine containing text, wrapping
+    // around to the start. Returns npos if there is no match.
+    size_t Find( std::string_view text, size_t fromLine ) const;
+
+    static constexpr size_t npos = std::string_view::npos;
+
+private:
+    void Trim();
+    size_t GetUsage() const { return GetByteCount() + m_starts.size() * sizeof( size_t ); }
+    size_t LineFromOffset( size_t offset ) const;
+
+    size_t m_capacity;
+    std::string m_text;          // Text of all lines, including the '\n's.
+    std::deque<size_t> m_starts; // Start of each line, as an offset from m_base.
+    size_t m_base;               // Offset of the start of m_text.
+    size_t m_dropped;
+};
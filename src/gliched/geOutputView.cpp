@@ -0,0 +1,177 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geOutputView.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Virtual output pane control class source.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "geOutputView.h"
+
+#include <wx/clipbrd.h>
+#include <wx/dcbuffer.h>
+#include <wx/settings.h>
+
+#include <algorithm>
+
+// Default limit on the output kept.
+constexpr size_t OUTPUT_CAPACITY = 64 * 1024 * 1024;
+
+// Only about this many bytes of a very long line are drawn.
+constexpr size_t MAX_DRAW_BYTES = 2000;
+
+geOutputView::geOutputView( wxWindow* parent, wxWindowID id, const wxSize& size )
+    : wxVScrolledWindow( parent, id, wxDefaultPosition, size, wxBORDER_THEME | wxWANTS_CHARS ),
+    m_lines( OUTPUT_CAPACITY ), m_selected( geOutputLines::npos )
+{
+    SetBackgroundStyle( wxBG_STYLE_PAINT );
+    SetBackgroundColour( wxSystemSettings::GetColour( wxSYS_COLOUR_WINDOW ) );
+    SetFont( wxFont( 10, wxFONTFAMILY_MODERN, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL ) );
+    m_lineHeight = GetCharHeight() + 2;
+    SetRowCount( 0 );
+
+    Bind( wxEVT_PAINT, &geOutputView::OnPaint, this );
+    Bind( wxEVT_LEFT_DOWN, &geOutputView::OnLeftDown, this );
+    Bind( wxEVT_KEY_DOWN, &geOutputView::OnKeyDown, this );
+}
+
+void geOutputView::AppendText( std::string_view text )
+{
+    size_t dropped = m_lines.GetDroppedLineCount();
+    m_lines.Append( text );
+    dropped = m_lines.GetDroppedLineCount() - dropped;
+    if( m_selected != geOutputLines::npos ) {
+        m_selected = (m_selected >= dropped) ? m_selected - dropped : geOutputLines::npos;
+    }
+    UpdateRowCount();
+}
+
+void geOutputView::Clear()
+{
+    m_lines.Clear();
+    m_selected = geOutputLines::npos;
+    UpdateRowCount();
+}
+
+void geOutputView::SetCapacity( size_t bytes )
+{
+    m_lines.SetCapacity( bytes );
+    m_selected = geOutputLines::npos;
+    UpdateRowCount();
+}
+
+bool geOutputView::FindNext( const wxString& text )
+{
+    size_t from = (m_selected == geOutputLines::npos) ? 0 : m_selected + 1;
+    if( from >= m_lines.GetLineCount() ) {
+        from = 0;
+    }
+    wxScopedCharBuffer utf8 = text.utf8_str();
+    size_t line = m_lines.Find( std::string_view( utf8.data(), utf8.length() ), from );
+    if( line == geOutputLines::npos ) {
+        return false;
+    }
+    m_selected = line;
+    ScrollToRow( line );
+    Refresh();
+    return true;
+}
+
+wxCoord geOutputView::OnGetRowHeight( size_t ) const
+{
+    return m_lineHeight;
+}
+
+// Keep following the end of the output if it was already in view.
+void geOutputView::UpdateRowCount()
+{
+    size_t count = m_lines.GetLineCount();
+    bool atEnd = GetVisibleRowsEnd() >= GetRowCount();
+    SetRowCount( count );
+    if( atEnd ) {
+        size_t visible = GetClientSize().y / m_lineHeight;
+        ScrollToRow( count > visible ? count - visible : 0 );
+    }
+    Refresh();
+}
+
+void geOutputView::OnPaint( wxPaintEvent& )
+{
+    wxAutoBufferedPaintDC dc( this );
+    dc.SetBackground( GetBackgroundColour() );
+    dc.Clear();
+    dc.SetFont( GetFont() );
+    dc.SetTextForeground( GetForegroundColour() );
+
+    int width = GetClientSize().x;
+    size_t first = GetVisibleRowsBegin();
+    size_t last = std::min( GetVisibleRowsEnd(), m_lines.GetLineCount() );
+    for( size_t row = first; row < last; ++row ) {
+        wxCoord y = static_cast<wxCoord>( row - first ) * m_lineHeight;
+        if( row == m_selected ) {
+            dc.SetBrush( wxSystemSettings::GetColour( wxSYS_COLOUR_HIGHLIGHT ) );
+            dc.SetPen( *wxTRANSPARENT_PEN );
+            dc.DrawRectangle( 0, y, width, m_lineHeight );
+            dc.SetTextForeground( wxSystemSettings::GetColour( wxSYS_COLOUR_HIGHLIGHTTEXT ) );
+        }
+        std::string_view line = m_lines.GetLine( row );
+        if( line.size() > MAX_DRAW_BYTES ) {
+            // Cut at the start of a UTF-8 sequence, as FromUTF8 gives an
+            // empty string for invalid text.
+            size_t size = MAX_DRAW_BYTES;
+            while( size > 0 && ( static_cast<unsigned char>( line[size] ) & 0xC0 ) == 0x80 ) {
+                --size;
+            }
+            line = line.substr( 0, size );
+        }
+        dc.DrawText( wxString::FromUTF8( line.data(), line.size() ), 2, y + 1 );
+        if( row == m_selected ) {
+            dc.SetTextForeground( GetForegroundColour() );
+        }
+    }
+}
+
+void geOutputView::OnLeftDown( wxMouseEvent& event )
+{
+    SetFocus();
+    size_t row = GetVisibleRowsBegin() + event.GetY() / m_lineHeight;
+    m_selected = (row < m_lines.GetLineCount()) ? row : geOutputLines::npos;
+    Refresh();
+}
+
+void geOutputView::OnKeyDown( wxKeyEvent& event )
+{
+    if( event.GetModifiers() == wxMOD_CONTROL && event.GetKeyCode() == 'C' ) {
+        CopySelection();
+        return;
+    }
+    event.Skip();
+}
+
+void geOutputView::CopySelection()
+{
+    if( m_selected == geOutputLines::npos || !wxTheClipboard->Open() ) {
+        return;
+    }
+    std::string_view line = m_lines.GetLine( m_selected );
+    wxTheClipboard->SetData( new wxTextDataObject( wxString::FromUTF8( line.data(), line.size() ) ) );
+    wxTheClipboard->Close();
+}
@@ -0,0 +1,68 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geOutputView.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Virtual output pane control class header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include "geOutputLines.h"
+
+#include <wx/vscroll.h>
+
+#include <string_view>
+
+// Read-only output pane that only draws the visible lines, so the cost of
+// scrolling and appending does not depend on how much output there is.
+class geOutputView : public wxVScrolledWindow
+{
+public:
+    geOutputView( wxWindow* parent, wxWindowID id, const wxSize& size );
+
+    void AppendText( std::string_view text );
+    void Clear();
+
+    // Limit the output kept, in bytes. The oldest lines are dropped first.
+    void SetCapacity( size_t bytes );
+    size_t GetCapacity() const { return m_lines.GetCapacity(); }
+
+    // Select and show the next line containing text, after the selected
+    // line. Returns false if no line matches.
+    bool FindNext( const wxString& text );
+
+    size_t GetLineCount() const { return m_lines.GetLineCount(); }
+
+private:
+    wxCoord OnGetRowHeight( size_t row ) const override;
+
+    void OnPaint( wxPaintEvent& event );
+    void OnLeftDown( wxMouseEvent& event );
+    void OnKeyDown( wxKeyEvent& event );
+
+    void UpdateRowCount();
+    void CopySelection();
+
+    geOutputLines m_lines;
+    wxCoord m_lineHeight;
+    size_t m_selected;  // Selected line, or geOutputLines::npos.
+};
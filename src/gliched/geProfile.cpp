@@ -0,0 +1,119 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geProfile.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Script profiler and its results.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+
+ */
+
+#include "geProfile.h"
+#include "geScriptError.h"
+
+#include <glc/hic.h>
+#include <gltok/gltok.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+
+static std::string RunStatement( const std::string& statement, const std::string& locus )
+{
+    try {
+        return glich::hic().run_script( statement, locus );
+    }
+    catch( const std::exception& e ) {
+        return std::string( "Error: " ) + e.what() + "\n";
+    }
+}
+
+void geProfileScript( const std::string& script, const std::string& locus,
+    const std::function<void( std::string&& )>& append, geRunStats& stats, geProfile& profile,
+    const std::atomic<bool>& cancelled )
+{
+    constexpr size_t maxText = 80;
+    int line = 0;
+    size_t pos = 0;
+    for( gltok::Range range : gltok::top_level_statements( script ) ) {
+        if( cancelled ) {
+            break;
+        }
+        line += static_cast<int>( std::count( script.begin() + pos, script.begin() + range.start, '\n' ) );
+        pos = range.start;
+        std::string statement = script.substr( range.start, range.length );
+
+        auto start = std::chrono::steady_clock::now();
+        std::string result = RunStatement( statement, locus );
+        double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+        int lineCount = 1 + static_cast<int>( std::count( statement.begin(), statement.end(), '\n' ) );
+        std::string text = statement.substr( 0, std::min( statement.find( '\n' ), maxText ) );
+        profile.push_back( { line, lineCount, seconds, text } );
+
+        // The interpreter numbers the lines of the statement from its start.
+        bool failed = geEndsWithError( result );
+        result = geOffsetErrorLines( result, line );
+        stats.CountOutput( result );
+        append( std::move( result ) );
+        if( failed ) {
+            break;
+        }
+    }
+}
+
+// Each entry is written as "line lineCount seconds text". The text is the
+// start of the first line of a statement, so holds no line ends.
+std::string geSerializeProfile( const geProfile& profile )
+{
+    std::string text;
+    char buf[64];
+    for( const geProfileEntry& entry : profile ) {
+        std::snprintf( buf, sizeof( buf ), "%d %d %.9g ", entry.line, entry.lineCount, entry.seconds );
+        text += buf;
+        text += entry.text;
+        text += '\n';
+    }
+    return text;
+}
+
+bool geParseProfile( const std::string& text, geProfile& profile )
+{
+    profile.clear();
+    size_t pos = 0;
+    while( pos < text.size() ) {
+        size_t end = text.find( '\n', pos );
+        if( end == std::string::npos ) {
+            return false;
+        }
+        geProfileEntry entry;
+        int length = 0;
+        std::string line = text.substr( pos, end - pos );
+        if( std::sscanf( line.c_str(), "%d %d %lf %n", &entry.line, &entry.lineCount, &entry.seconds, &length ) < 3 ) {
+            return false;
+        }
+        entry.text = line.substr( length );
+        profile.push_back( std::move( entry ) );
+        pos = end + 1;
+    }
+    return true;
+}
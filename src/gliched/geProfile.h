@@ -0,0 +1,59 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geProfile.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Script profiler and its results header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include "geRunStats.h"
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+// The time taken by one top level statement of a profiled run.
+struct geProfileEntry
+{
+    int line;           // First line of the statement, from 0.
+    int lineCount;
+    double seconds;     // Inclusive time.
+    std::string text;   // The start of the statement, for display.
+};
+
+using geProfile = std::vector<geProfileEntry>;
+
+// Run script with the glich::hic() interpreter one top level statement at a
+// time, timing each one. The interpreter keeps its state between statements,
+// so the result is the same as a normal run. Each statement's output is
+// passed to append as soon as it is done, with its error line numbers
+// counted from the start of the script. Stops early if cancelled is set, and
+// at the first statement that fails, as a whole script run would.
+void geProfileScript( const std::string& script, const std::string& locus,
+    const std::function<void( std::string&& )>& append, geRunStats& stats, geProfile& profile,
+    const std::atomic<bool>& cancelled );
+
+// A profile as text, one entry per line, to pass between processes.
+std::string geSerializeProfile( const geProfile& profile );
+bool geParseProfile( const std::string& text, geProfile& profile );
@@ -0,0 +1,115 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geProfileView.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Script profile list.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "geProfileView.h"
+
+#include <algorithm>
+
+enum {
+    COL_LINE,
+    COL_LINES,
+    COL_TIME,
+    COL_PERCENT,
+    COL_STATEMENT
+};
+
+geProfileView::geProfileView( wxWindow* parent, wxWindowID id, const wxSize& size )
+    : wxListCtrl( parent, id, wxDefaultPosition, size, wxLC_REPORT | wxLC_VIRTUAL | wxLC_SINGLE_SEL ),
+    m_total( 0.0 ), m_sortColumn( COL_TIME ), m_sortAscending( false )
+{
+    AppendColumn( "Line", wxLIST_FORMAT_RIGHT, 50 );
+    AppendColumn( "Lines", wxLIST_FORMAT_RIGHT, 50 );
+    AppendColumn( "Time ms", wxLIST_FORMAT_RIGHT, 80 );
+    AppendColumn( "%", wxLIST_FORMAT_RIGHT, 50 );
+    AppendColumn( "Statement", wxLIST_FORMAT_LEFT, 300 );
+
+    Bind( wxEVT_LIST_COL_CLICK, &geProfileView::OnColumnClick, this );
+}
+
+void geProfileView::SetProfile( const geProfile& profile )
+{
+    m_profile = profile;
+    m_total = 0.0;
+    for( const geProfileEntry& entry : m_profile ) {
+        m_total += entry.seconds;
+    }
+    Sort();
+}
+
+void geProfileView::Clear()
+{
+    m_profile.clear();
+    m_total = 0.0;
+    SetItemCount( 0 );
+    Refresh();
+}
+
+wxString geProfileView::OnGetItemText( long item, long column ) const
+{
+    const geProfileEntry& entry = m_profile[item];
+    switch( column ) {
+    case COL_LINE: return wxString::Format( "%d", entry.line + 1 );
+    case COL_LINES: return wxString::Format( "%d", entry.lineCount );
+    case COL_TIME: return wxString::Format( "%.3f", entry.seconds * 1e3 );
+    case COL_PERCENT: return m_total > 0.0 ? wxString::Format( "%.1f", entry.seconds * 100.0 / m_total ) : "";
+    case COL_STATEMENT: return wxString::FromUTF8( entry.text );
+    }
+    return wxString();
+}
+
+void geProfileView::OnColumnClick( wxListEvent& event )
+{
+    int column = event.GetColumn();
+    if( column < 0 ) return;
+    if( column == m_sortColumn ) {
+        m_sortAscending = !m_sortAscending;
+    }
+    else {
+        m_sortColumn = column;
+        m_sortAscending = column == COL_LINE || column == COL_STATEMENT;
+    }
+    Sort();
+}
+
+void geProfileView::Sort()
+{
+    auto key = [this]( const geProfileEntry& entry ) -> double {
+        switch( m_sortColumn ) {
+        case COL_LINES: return entry.lineCount;
+        case COL_TIME: case COL_PERCENT: return entry.seconds;
+        }
+        return entry.line;
+    };
+    std::stable_sort( m_profile.begin(), m_profile.end(), [&]( const geProfileEntry& a, const geProfileEntry& b ) {
+        if( m_sortColumn == COL_STATEMENT && a.text != b.text ) {
+            return m_sortAscending ? a.text < b.text : b.text < a.text;
+        }
+        return m_sortAscending ? key( a ) < key( b ) : key( b ) < key( a );
+    } );
+    ShowSortIndicator( m_sortColumn, m_sortAscending );
+    SetItemCount( static_cast<long>( m_profile.size() ) );
+    Refresh();
+}
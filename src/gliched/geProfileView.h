@@ -0,0 +1,55 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geProfileView.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Script profile list header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include "geProfile.h"
+
+#include <wx/listctrl.h>
+
+// Lists the statements of a profiled run, slowest first by default and
+// sortable by clicking a column. Activating an item sends the usual
+// wxEVT_LIST_ITEM_ACTIVATED, and GetLine gives its line in the script.
+class geProfileView : public wxListCtrl
+{
+public:
+    geProfileView( wxWindow* parent, wxWindowID id, const wxSize& size );
+
+    void SetProfile( const geProfile& profile );
+    void Clear();
+
+    int GetLine( long item ) const { return m_profile[item].line; }
+
+private:
+    wxString OnGetItemText( long item, long column ) const override;
+    void OnColumnClick( wxListEvent& event );
+    void Sort();
+
+    geProfile m_profile;
+    double m_total;
+    int m_sortColumn;
+    bool m_sortAscending;
+};
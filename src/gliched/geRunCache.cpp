@@ -0,0 +1,198 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geRunCache.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Cache of script run results.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "geRunCache.h"
+
+#include "geHash.h"
+#include "geModules.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+geRunCache::geRunCache( const std::string& dir, size_t maxBytes )
+    : m_dir( dir ), m_maxBytes( maxBytes ), m_size( 0 )
+{
+    std::error_code ec;
+    fs::create_directories( m_dir, ec );
+    for( const fs::directory_entry& entry : fs::directory_iterator( m_dir, ec ) ) {
+        if( entry.path().extension() == ".out" ) {
+            m_size += static_cast<size_t>( entry.file_size( ec ) );
+        }
+    }
+    Trim();
+}
+
+geRunKey geRunCache::MakeKey(
+    std::string_view script, const std::vector<std::string>& modulePaths,
+    std::string_view version, uint64_t stateHash )
+{
+    geRunKey key;
+    if( geUsesOutsideData( script ) ) {
+        return key;
+    }
+    // The digest holds the script itself, and a second hash of all of the
+    // input from another offset basis, so a false match needs both hashes
+    // to collide for the same script.
+    geHasher hasher;
+    geHasher check( 0x84222325cbf29ce4ull );
+    auto add = [&hasher, &check]( auto value ) {
+        hasher.Add( value );
+        check.Add( value );
+    };
+    add( version );
+    add( stateHash );
+    add( script );
+    for( const std::string& dir : modulePaths ) {
+        add( std::string_view( dir ) );
+    }
+    for( const geModuleFile& module : geFindModules( script, modulePaths ) ) {
+        if( geUsesOutsideData( module.text ) ) {
+            return key;
+        }
+        add( std::string_view( module.path ) );
+        add( std::string_view( module.text ) );
+    }
+    key.id = hasher.Get() | 1;
+    key.digest = geHasher::ToHex( check.Get() );
+    key.digest += script;
+    return key;
+}
+
+std::string geRunCache::GetPath( uint64_t key ) const
+{
+    return ( fs::path( m_dir ) / ( geHasher::ToHex( key ) + ".out" ) ).string();
+}
+
+// Each entry file holds the size of the key's digest on the first line,
+// then the digest, then the output.
+bool geRunCache::Find( const geRunKey& key, std::string& output )
+{
+    std::string path = GetPath( key.id );
+    std::ifstream in( path, std::ios::binary );
+    if( !in ) {
+        return false;
+    }
+    std::ostringstream text;
+    text << in.rdbuf();
+    std::string entry = text.str();
+    std::string header = std::to_string( key.digest.size() ) + "\n";
+    if( entry.compare( 0, header.size(), header ) != 0
+        || entry.compare( header.size(), key.digest.size(), key.digest ) != 0 ) {
+        return false;
+    }
+    output = entry.substr( header.size() + key.digest.size() );
+
+    // The modification time records when the result was last used.
+    std::error_code ec;
+    fs::last_write_time( path, fs::file_time_type::clock::now(), ec );
+    return true;
+}
+
+void geRunCache::Store( const geRunKey& key, std::string_view output )
+{
+    if( output.size() > m_maxBytes / 4 ) {
+        return;
+    }
+    // Write to a temporary file first so that a partly written result is
+    // never found.
+    std::string path = GetPath( key.id );
+    std::string temp = path + ".tmp";
+    std::string header = std::to_string( key.digest.size() ) + "\n";
+    size_t size = header.size() + key.digest.size() + output.size();
+    {
+        std::ofstream out( temp, std::ios::binary | std::ios::trunc );
+        out.write( header.data(), header.size() );
+        out.write( key.digest.data(), key.digest.size() );
+        out.write( output.data(), output.size() );
+        if( !out ) {
+            return;
+        }
+    }
+    std::error_code ec;
+    uintmax_t oldSize = fs::file_size( path, ec );
+    if( ec ) {
+        oldSize = 0;
+    }
+    fs::rename( temp, path, ec );
+    if( ec ) {
+        fs::remove( temp, ec );
+        return;
+    }
+    m_size = m_size - static_cast<size_t>( std::min<uintmax_t>( oldSize, m_size ) ) + size;
+    Trim();
+}
+
+void geRunCache::Clear()
+{
+    std::error_code ec;
+    for( const fs::directory_entry& entry : fs::directory_iterator( m_dir, ec ) ) {
+        if( entry.path().extension() == ".out" ) {
+            fs::remove( entry.path(), ec );
+        }
+    }
+    m_size = 0;
+}
+
+// Remove the least recently used results until the total is below three
+// quarters of the limit, so that trimming is not needed on every store.
+void geRunCache::Trim()
+{
+    if( m_size <= m_maxBytes ) {
+        return;
+    }
+    struct Entry
+    {
+        fs::file_time_type time;
+        fs::path path;
+        size_t size;
+    };
+    std::vector<Entry> entries;
+    std::error_code ec;
+    for( const fs::directory_entry& entry : fs::directory_iterator( m_dir, ec ) ) {
+        if( entry.path().extension() == ".out" ) {
+            entries.push_back( { entry.last_write_time( ec ), entry.path(), static_cast<size_t>( entry.file_size( ec ) ) } );
+        }
+    }
+    std::sort( entries.begin(), entries.end(),
+        []( const Entry& a, const Entry& b ) { return a.time < b.time; } );
+    m_size = 0;
+    for( const Entry& entry : entries ) {
+        m_size += entry.size;
+    }
+    size_t target = m_maxBytes / 4 * 3;
+    for( const Entry& entry : entries ) {
+        if( m_size <= target ) {
+            break;
+        }
+        if( fs::remove( entry.path, ec ) ) {
+            m_size -= entry.size;
+        }
+    }
+}
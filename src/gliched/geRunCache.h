@@ -0,0 +1,72 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geRunCache.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Cache of script run results header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Identifies a cached run. The id names the cache entry. The digest is
+// stored with the entry and compared when it is found, so that two runs
+// whose ids collide are never mistaken for each other.
+struct geRunKey
+{
+    uint64_t id = 0;        // 0 if the run must not be cached.
+    std::string digest;
+};
+
+// Stores the output of script runs on disk, keyed by a hash of everything
+// that the run depends on. When the total size exceeds the limit the
+// least recently used results are removed.
+class geRunCache
+{
+public:
+    geRunCache( const std::string& dir, size_t maxBytes );
+
+    // The key for running script with the given module search paths, from
+    // an interpreter of the given version whose state hashes to stateHash.
+    // Every file in the module paths that the script could refer to,
+    // directly or through another module, is included by its exact path.
+    // The id is 0, meaning the run must not be cached, if the script or a
+    // module it uses depends on the date or on data files.
+    static geRunKey MakeKey(
+        std::string_view script, const std::vector<std::string>& modulePaths,
+        std::string_view version, uint64_t stateHash );
+
+    bool Find( const geRunKey& key, std::string& output );
+    void Store( const geRunKey& key, std::string_view output );
+    void Clear();
+
+private:
+    std::string GetPath( uint64_t key ) const;
+    void Trim();
+
+    std::string m_dir;
+    size_t m_maxBytes;
+    size_t m_size;      // Total size of the cached files.
+};
@@ -0,0 +1,151 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geRunHistory.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Run history list control class source.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "geRunHistory.h"
+
+#include <algorithm>
+
+// The number of runs kept in the history.
+constexpr size_t MAX_RUN_HISTORY = 500;
+
+enum {
+    COL_NUMBER,
+    COL_TIME,
+    COL_SCRIPT,
+    COL_WALL,
+    COL_USER,
+    COL_SYSTEM,
+    COL_MEMORY,
+    COL_BYTES,
+    COL_LINES,
+    COL_RESULT
+};
+
+geRunHistory::geRunHistory( wxWindow* parent, wxWindowID id, const wxSize& size )
+    : wxListCtrl( parent, id, wxDefaultPosition, size, wxLC_REPORT | wxLC_VIRTUAL | wxLC_SINGLE_SEL ),
+    m_runCount( 0 ), m_sortColumn( COL_NUMBER ), m_sortAscending( false )
+{
+    AppendColumn( "#", wxLIST_FORMAT_RIGHT, 40 );
+    AppendColumn( "Time", wxLIST_FORMAT_LEFT, 70 );
+    AppendColumn( "Script", wxLIST_FORMAT_LEFT, 120 );
+    AppendColumn( "Wall ms", wxLIST_FORMAT_RIGHT, 70 );
+    AppendColumn( "User ms", wxLIST_FORMAT_RIGHT, 70 );
+    AppendColumn( "System ms", wxLIST_FORMAT_RIGHT, 70 );
+    AppendColumn( "Peak +KB", wxLIST_FORMAT_RIGHT, 70 );
+    AppendColumn( "Output bytes", wxLIST_FORMAT_RIGHT, 90 );
+    AppendColumn( "Lines", wxLIST_FORMAT_RIGHT, 60 );
+    AppendColumn( "Result", wxLIST_FORMAT_LEFT, 70 );
+
+    Bind( wxEVT_LIST_COL_CLICK, &geRunHistory::OnColumnClick, this );
+}
+
+void geRunHistory::AddRun( const wxString& name, const geRunStats& stats )
+{
+    if( m_runs.size() >= MAX_RUN_HISTORY ) {
+        auto oldest = std::min_element( m_runs.begin(), m_runs.end(),
+            []( const Run& a, const Run& b ) { return a.number < b.number; } );
+        m_runs.erase( oldest );
+    }
+    m_runs.push_back( { ++m_runCount, wxDateTime::Now(), name, stats } );
+    Sort();
+}
+
+wxString geRunHistory::Summary( const wxString& name, const geRunStats& stats )
+{
+    if( stats.cached ) {
+        return wxString::Format( "%s unchanged, cached output shown, %zu lines, %zu bytes",
+            name, stats.outputLines, stats.outputBytes );
+    }
+    return wxString::Format( "%s %s in %.0f ms (CPU %.0f ms user, %.0f ms system), peak +%zu KB, %zu lines, %zu bytes",
+        stats.cancelled ? "Stopped" : "Finished", name,
+        stats.wall * 1e3, stats.user * 1e3, stats.system * 1e3,
+        stats.peakRssDelta / 1024, stats.outputLines, stats.outputBytes );
+}
+
+wxString geRunHistory::Result( const geRunStats& stats )
+{
+    if( stats.cancelled ) {
+        return "Stopped";
+    }
+    return stats.cached ? "Cached" : "Finished";
+}
+
+wxString geRunHistory::OnGetItemText( long item, long column ) const
+{
+    const Run& run = m_runs[item];
+    switch( column ) {
+    case COL_NUMBER: return wxString::Format( "%d", run.number );
+    case COL_TIME: return run.time.FormatISOTime();
+    case COL_SCRIPT: return run.name;
+    case COL_WALL: return wxString::Format( "%.1f", run.stats.wall * 1e3 );
+    case COL_USER: return wxString::Format( "%.1f", run.stats.user * 1e3 );
+    case COL_SYSTEM: return wxString::Format( "%.1f", run.stats.system * 1e3 );
+    case COL_MEMORY: return wxString::Format( "%zu", run.stats.peakRssDelta / 1024 );
+    case COL_BYTES: return wxString::Format( "%zu", run.stats.outputBytes );
+    case COL_LINES: return wxString::Format( "%zu", run.stats.outputLines );
+    case COL_RESULT: return Result( run.stats );
+    }
+    return wxString();
+}
+
+void geRunHistory::OnColumnClick( wxListEvent& event )
+{
+    int column = event.GetColumn();
+    if( column < 0 ) return;
+    if( column == m_sortColumn ) {
+        m_sortAscending = !m_sortAscending;
+    }
+    else {
+        m_sortColumn = column;
+        m_sortAscending = true;
+    }
+    Sort();
+}
+
+void geRunHistory::Sort()
+{
+    auto key = [this]( const Run& run ) -> double {
+        switch( m_sortColumn ) {
+        case COL_WALL: return run.stats.wall;
+        case COL_USER: return run.stats.user;
+        case COL_SYSTEM: return run.stats.system;
+        case COL_MEMORY: return static_cast<double>( run.stats.peakRssDelta );
+        case COL_BYTES: return static_cast<double>( run.stats.outputBytes );
+        case COL_LINES: return static_cast<double>( run.stats.outputLines );
+        case COL_RESULT: return run.stats.cancelled ? 2.0 : run.stats.cached ? 1.0 : 0.0;
+        }
+        return run.number; // Also the time order.
+    };
+    std::stable_sort( m_runs.begin(), m_runs.end(), [&]( const Run& a, const Run& b ) {
+        if( m_sortColumn == COL_SCRIPT && a.name != b.name ) {
+            return m_sortAscending ? a.name < b.name : b.name < a.name;
+        }
+        return m_sortAscending ? key( a ) < key( b ) : key( b ) < key( a );
+    } );
+    ShowSortIndicator( m_sortColumn, m_sortAscending );
+    SetItemCount( static_cast<long>( m_runs.size() ) );
+    Refresh();
+}
@@ -0,0 +1,65 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geRunHistory.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Run history list control class header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include "geRunStats.h"
+
+#include <wx/datetime.h>
+#include <wx/listctrl.h>
+
+#include <vector>
+
+// Lists the measurements of recent runs, sortable by clicking a column.
+class geRunHistory : public wxListCtrl
+{
+public:
+    geRunHistory( wxWindow* parent, wxWindowID id, const wxSize& size );
+
+    void AddRun( const wxString& name, const geRunStats& stats );
+
+    // A one line summary for the status bar.
+    static wxString Summary( const wxString& name, const geRunStats& stats );
+
+private:
+    struct Run
+    {
+        int number;
+        wxDateTime time;
+        wxString name;
+        geRunStats stats;
+    };
+
+    static wxString Result( const geRunStats& stats );
+    wxString OnGetItemText( long item, long column ) const override;
+    void OnColumnClick( wxListEvent& event );
+    void Sort();
+
+    std::vector<Run> m_runs;
+    int m_runCount;
+    int m_sortColumn;
+    bool m_sortAscending;
+};
@@ -0,0 +1,110 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geRunStats.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Script run performance measurements source.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "geRunStats.h"
+
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#if defined(_WIN32)
+
+static double FileTimeSeconds( const FILETIME& ft )
+{
+    ULARGE_INTEGER ticks;
+    ticks.LowPart = ft.dwLowDateTime;
+    ticks.HighPart = ft.dwHighDateTime;
+    return ticks.QuadPart / 1e7; // 100ns units.
+}
+
+geResourceUsage geResourceUsage::ForCurrentThread()
+{
+    geResourceUsage usage;
+    FILETIME created, exited, kernel, user;
+    if( GetThreadTimes( GetCurrentThread(), &created, &exited, &kernel, &user ) ) {
+        usage.user = FileTimeSeconds( user );
+        usage.system = FileTimeSeconds( kernel );
+    }
+    PROCESS_MEMORY_COUNTERS pmc;
+    if( GetProcessMemoryInfo( GetCurrentProcess(), &pmc, sizeof( pmc ) ) ) {
+        usage.peakRss = pmc.PeakWorkingSetSize;
+    }
+    return usage;
+}
+
+#else
+
+static double TimevalSeconds( const timeval& tv )
+{
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+geResourceUsage geResourceUsage::ForCurrentThread()
+{
+    geResourceUsage usage;
+    rusage ru;
+#if defined(RUSAGE_THREAD)
+    if( getrusage( RUSAGE_THREAD, &ru ) == 0 ) {
+#else
+    // No per-thread figures, so this includes the GUI thread.
+    if( getrusage( RUSAGE_SELF, &ru ) == 0 ) {
+#endif
+        usage.user = TimevalSeconds( ru.ru_utime );
+        usage.system = TimevalSeconds( ru.ru_stime );
+    }
+    if( getrusage( RUSAGE_SELF, &ru ) == 0 ) {
+#if defined(__APPLE__)
+        usage.peakRss = static_cast<size_t>( ru.ru_maxrss );        // Bytes.
+#else
+        usage.peakRss = static_cast<size_t>( ru.ru_maxrss ) * 1024; // KB.
+#endif
+    }
+    return usage;
+}
+
+#endif
+
+void geRunStats::CountOutput( std::string_view output )
+{
+    outputBytes += output.size();
+    outputLines += std::count( output.begin(), output.end(), '\n' );
+}
+
+geRunStats geRunTimer::Stop() const
+{
+    geResourceUsage usage = geResourceUsage::ForCurrentThread();
+    geRunStats stats;
+    stats.wall = std::chrono::duration<double>( std::chrono::steady_clock::now() - m_start ).count();
+    stats.user = usage.user - m_usage.user;
+    stats.system = usage.system - m_usage.system;
+    stats.peakRssDelta = (usage.peakRss > m_usage.peakRss) ? usage.peakRss - m_usage.peakRss : 0;
+    return stats;
+}
@@ -0,0 +1,72 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geRunStats.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Script run performance measurements header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+
+// CPU time used by the calling thread, and the peak memory of the process.
+struct geResourceUsage
+{
+    double user = 0.0;    // Seconds.
+    double system = 0.0;  // Seconds.
+    size_t peakRss = 0;   // Bytes.
+
+    static geResourceUsage ForCurrentThread();
+};
+
+// Measurements for a single script run.
+struct geRunStats
+{
+    double wall = 0.0;     // Seconds.
+    double user = 0.0;     // Seconds.
+    double system = 0.0;   // Seconds.
+    size_t peakRssDelta = 0; // Growth of the process peak memory, in bytes.
+    size_t outputBytes = 0;
+    size_t outputLines = 0;
+    bool cancelled = false;
+    bool interactive = false; // The script asked for input.
+    bool cached = false;      // The output came from the result cache.
+
+    void CountOutput( std::string_view output );
+};
+
+// Measures a run on the thread that creates it.
+class geRunTimer
+{
+public:
+    geRunTimer()
+        : m_start( std::chrono::steady_clock::now() ),
+        m_usage( geResourceUsage::ForCurrentThread() ) {}
+
+    geRunStats Stop() const;
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+    geResourceUsage m_usage;
+};
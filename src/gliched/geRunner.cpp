@@ -0,0 +1,140 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geRunner.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Run scripts on a worker thread, class source.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "geRunner.h"
+
+#include <glc/hic.h>
+
+#include <exception>
+
+std::atomic<bool> geRunner::s_cancelled( false );
+std::atomic<bool> geRunner::s_inputRequested( false );
+std::atomic<int> geRunner::s_active( 0 );
+
+geRunner::~geRunner()
+{
+    Abandon();
+}
+
+static std::string RunScript( const std::string& script, const std::string& locus )
+{
+    try {
+        return glich::hic().run_script( script, locus );
+    }
+    catch( const std::exception& e ) {
+        return std::string( "Error: " ) + e.what() + "\n";
+    }
+}
+
+bool geRunner::Start( std::string script, const std::string& locus, const Options& options,
+    geOutputBuffer* output, DoneFunc done )
+{
+    if( m_running || IsActive() ) {
+        return false;
+    }
+    Join();
+    m_running = true;
+    s_cancelled = false;
+    s_inputRequested = false;
+    ++s_active;
+    m_results = std::make_shared<Results>();
+    m_link = std::make_shared<Link>();
+
+    // The output buffer and the done function belong to the caller, so they
+    // are only used while the run is still attached to this geRunner.
+    auto link = m_link;
+    auto append = [link, output]( std::string&& text ) {
+        std::lock_guard<std::mutex> lock( link->mutex );
+        if( link->attached && !s_cancelled ) {
+            output->Append( std::move( text ) );
+        }
+    };
+    m_thread = std::thread( [script = std::move( script ), locus, options, results = m_results, link, append, done]() {
+        geRunTimer timer;
+        geRunStats counts;
+        if( options.profile ) {
+            geProfileScript( script, locus, append, counts, results->profile, s_cancelled );
+        }
+        else {
+            // The interpreter returns all of its output when the script ends,
+            // which is then moved into the buffer. Only output small enough
+            // for the run cache is copied first, to be kept with the results.
+            std::string result = RunScript( script, locus );
+            counts.CountOutput( result );
+            if( result.size() <= options.keepOutput ) {
+                results->output = result;
+            }
+            append( std::move( result ) );
+        }
+        geRunStats stats = timer.Stop();
+        stats.outputBytes = counts.outputBytes;
+        stats.outputLines = counts.outputLines;
+        stats.cancelled = s_cancelled;
+        stats.interactive = s_inputRequested;
+        // The GUI thread must not use the interpreter while it is active,
+        // so take the snapshot for the State pane here.
+        results->state = std::make_shared<const geState>( geState::Capture() );
+        results->stateHash = results->state->Hash();
+        --s_active;
+        std::lock_guard<std::mutex> lock( link->mutex );
+        if( link->attached ) {
+            done( stats );
+        }
+    } );
+    return true;
+}
+
+void geRunner::Cancel()
+{
+    if( m_running ) {
+        s_cancelled = true;
+    }
+}
+
+// A running script cannot be interrupted, so leave it to finish or to end
+// with the process. Once this returns, the run no longer uses the output
+// buffer or calls the done function.
+void geRunner::Abandon()
+{
+    if( m_thread.joinable() ) {
+        s_cancelled = true;
+        {
+            std::lock_guard<std::mutex> lock( m_link->mutex );
+            m_link->attached = false;
+        }
+        m_thread.detach();
+    }
+    m_running = false;
+}
+
+// Called on the GUI thread once the done function has been handled.
+void geRunner::Join()
+{
+    if( m_thread.joinable() ) {
+        m_thread.join();
+    }
+    m_running = false;
+}
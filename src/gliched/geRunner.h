@@ -0,0 +1,121 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geRunner.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Run scripts on a worker thread, class header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include "geOutputBuffer.h"
+#include "geProfile.h"
+#include "geRunStats.h"
+#include "geState.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Runs a script with the shared glich::hic() interpreter on a worker thread,
+// so that the GUI stays responsive. There is only one interpreter, so only
+// one script can run at a time and the GUI thread must not use glich::hic()
+// while a run is in progress.
+class geRunner
+{
+public:
+    // Called on the worker thread when the run has finished and all its
+    // output has been written to the output buffer.
+    using DoneFunc = std::function<void( const geRunStats& stats )>;
+
+    struct Options
+    {
+        // Run the script one top level statement at a time, timing each
+        // one. The interpreter keeps its state between statements, so the
+        // result is the same as a normal run.
+        bool profile = false;
+        // Keep a copy of the output for GetOutput, if it is no larger.
+        size_t keepOutput = 0;
+    };
+
+    geRunner() : m_running( false ), m_results( std::make_shared<Results>() ) {}
+    ~geRunner();
+
+    bool Start( std::string script, const std::string& locus, const Options& options,
+        geOutputBuffer* output, DoneFunc done );
+    void Cancel();
+    void Join();
+    // Let a running script carry on by itself, without using the output
+    // buffer or calling the done function that it was started with.
+    void Abandon();
+
+    bool IsRunning() const { return m_running; }
+
+    // The results of the last run, valid after Join.
+    const geProfile& GetProfile() const { return m_results->profile; }
+    const std::string& GetOutput() const { return m_results->output; }
+    // The interpreter state after the run, captured on the worker thread.
+    geStatePtr GetState() const { return m_results->state; }
+    uint64_t GetStateHash() const { return m_results->stateHash; }
+
+    // The interpreter has no way to interrupt a script, so cancelling only
+    // marks the run as unwanted. Input requests are answered with an empty
+    // string and the output is discarded when the script returns.
+    static bool IsCancelRequested() { return s_cancelled; }
+
+    // True while a run, possibly abandoned when its geRunner was destroyed,
+    // is still using the interpreter.
+    static bool IsActive() { return s_active > 0; }
+
+    // Called when the running script asks for input, which makes its
+    // result depend on more than the script.
+    static void NoteInputRequest() { s_inputRequested = true; }
+
+private:
+    struct Results
+    {
+        geProfile profile;
+        std::string output;
+        geStatePtr state;
+        uint64_t stateHash = 0;
+    };
+
+    // Shared with the worker thread, which only uses the caller's output
+    // buffer and done function while attached is true.
+    struct Link
+    {
+        std::mutex mutex;
+        bool attached = true;
+    };
+
+    std::thread m_thread;
+    bool m_running;
+    std::shared_ptr<Results> m_results;
+    std::shared_ptr<Link> m_link;
+
+    static std::atomic<bool> s_cancelled;
+    static std::atomic<bool> s_inputRequested;
+    static std::atomic<int> s_active;
+};
@@ -0,0 +1,73 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geScriptError.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Recognise the errors that Glich reports in its output.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+
+ */
+
+#include "geScriptError.h"
+
+#include <cctype>
+#include <cstdlib>
+
+bool geEndsWithError( std::string_view output )
+{
+    size_t end = output.find_last_not_of( '\n' );
+    if( end == std::string_view::npos ) {
+        return false;
+    }
+    size_t pos = output.rfind( '\n', end );
+    pos = (pos == std::string_view::npos) ? 0 : pos + 1;
+    std::string_view last = output.substr( pos );
+    return last.compare( 0, 6, "Error:" ) == 0 || last.compare( 0, 7, "Error (" ) == 0;
+}
+
+std::string geOffsetErrorLines( std::string_view output, int offset )
+{
+    const std::string_view prefix = "Error (";
+    std::string result;
+    result.reserve( output.size() + 16 );
+    size_t pos = 0;
+    while( pos < output.size() ) {
+        size_t end = output.find( '\n', pos );
+        end = (end == std::string_view::npos) ? output.size() : end + 1;
+        std::string_view line = output.substr( pos, end - pos );
+        size_t digits = prefix.size();
+        while( digits < line.size() && std::isdigit( static_cast<unsigned char>( line[digits] ) ) ) {
+            ++digits;
+        }
+        if( offset != 0 && line.compare( 0, prefix.size(), prefix ) == 0
+            && digits > prefix.size() && digits < line.size() && line[digits] == ')' )
+        {
+            std::string number( line.substr( prefix.size(), digits - prefix.size() ) );
+            result += prefix;
+            result += std::to_string( std::atol( number.c_str() ) + offset );
+            result += line.substr( digits );
+        }
+        else {
+            result += line;
+        }
+        pos = end;
+    }
+    return result;
+}
@@ -0,0 +1,41 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geScriptError.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Recognise the errors that Glich reports in its output, header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// Glich reports an error as an "Error (line): message" line in its output
+// and runs nothing more, so a script has failed if its output ends with
+// one. A run that ends with an exception out of the interpreter reports
+// "Error: message" instead.
+bool geEndsWithError( std::string_view output );
+
+// Add offset to the line number of each "Error (line):" line in output, for
+// a part of a script that starts offset lines into it.
+std::string geOffsetErrorLines( std::string_view output, int offset );
@@ -0,0 +1,317 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geSession.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Interpreter session in a child process.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "geSession.h"
+
+#include <wx/process.h>
+#include <wx/utils.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// Forwards the end of the process to its session, if there still is one.
+class geSession::Process : public wxProcess
+{
+public:
+    explicit Process( geSession* session ) : m_session( session ) { Redirect(); }
+
+    void OnTerminate( int, int ) override
+    {
+        if( m_session ) {
+            m_session->OnProcessEnded();
+        }
+        delete this;
+    }
+
+    geSession* m_session;
+};
+
+std::atomic<uint64_t> geSession::s_lastId( 0 );
+
+geSession::geSession( const wxString& command, DoneFunc done, InputFunc input )
+    : m_command( command ), m_done( done ), m_input( input ), m_process( nullptr ), m_pid( 0 ),
+    m_busy( false ), m_starting( false ), m_cancelled( false ), m_polling( false ), m_waitingForInput( false ),
+    m_profiling( false ), m_id( ++s_lastId ),
+    m_state( std::make_shared<const geState>() ), m_stateHash( m_state->Hash() ),
+    m_startStateHash( m_stateHash )
+{
+}
+
+// Kill the process, closing its input first so that an idle session still
+// ends if the kill fails. The detached process object deletes itself when
+// the child is reaped.
+geSession::~geSession()
+{
+    if( m_process ) {
+        m_process->m_session = nullptr;
+        m_process->CloseOutput();
+        Kill();
+        m_process->Detach();
+    }
+}
+
+bool geSession::Start()
+{
+    m_process = new Process( this );
+    // As group leader, the process and any children it starts can be
+    // killed together.
+    m_pid = wxExecute( m_command, wxEXEC_ASYNC | wxEXEC_HIDE_CONSOLE | wxEXEC_MAKE_GROUP_LEADER, m_process );
+    if( m_pid == 0 ) {
+        // The process object is still ours if nothing was started.
+        delete m_process;
+        m_process = nullptr;
+        return false;
+    }
+    m_incoming.clear();
+    m_starting = true;
+    m_state = std::make_shared<const geState>();
+    m_stateHash = m_state->Hash();
+    return true;
+}
+
+bool geSession::Run( const std::string& script, const std::vector<std::string>& modulePaths, bool profile )
+{
+    if( m_busy || ( !m_process && !Start() ) ) {
+        return false;
+    }
+    std::string paths;
+    for( const std::string& path : modulePaths ) {
+        paths += path + "\n";
+    }
+    m_busy = true;
+    m_cancelled = false;
+    m_profiling = profile;
+    m_profile.clear();
+    m_startStateHash = m_stateHash;
+    m_stats = geRunStats();
+    m_output.clear();
+    m_errors.clear();
+    if( m_starting ) {
+        // Wait until the process is reading its input, so that writing a
+        // large script can't block the GUI.
+        m_pendingPaths = paths;
+        m_pendingScript = script;
+        return true;
+    }
+    Send( "PATHS", paths );
+    Send( m_profiling ? "PROFILE" : "RUN", script );
+    return true;
+}
+
+bool geSession::Cancel()
+{
+    if( !m_busy || !m_process ) {
+        return false;
+    }
+    m_cancelled = Kill();
+    return m_cancelled;
+}
+
+// Kill the process group, or failing that the process alone.
+bool geSession::Kill()
+{
+    if( wxProcess::Kill( m_pid, wxSIGKILL, wxKILL_CHILDREN ) == wxKILL_OK ) {
+        return true;
+    }
+    return wxProcess::Kill( m_pid, wxSIGKILL ) == wxKILL_OK;
+}
+
+void geSession::Answer( const std::string& text )
+{
+    if( m_waitingForInput ) {
+        m_waitingForInput = false;
+        Send( "ANSWER", text );
+    }
+}
+
+bool geSession::RequestValue( const geStateRowKey& key, ValueFunc reply )
+{
+    if( !m_process || m_busy || m_starting ) {
+        return false;
+    }
+    m_valueReplies.push_back( std::move( reply ) );
+    Send( "VALUE", geState::SerializeKey( key ) );
+    return true;
+}
+
+void geSession::Send( const std::string& name, const std::string& payload )
+{
+    wxOutputStream* out = m_process ? m_process->GetOutputStream() : nullptr;
+    if( !out ) return;
+    char header[128];
+    int len = std::snprintf( header, sizeof( header ), "%s %zu\n", name.c_str(), payload.size() );
+    out->Write( header, len );
+    out->Write( payload.data(), payload.size() );
+}
+
+// Read whatever the process has sent and handle each complete message.
+void geSession::Poll()
+{
+    if( m_polling ) return;
+    if( m_parsed.valid() && m_parsed.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready ) {
+        std::pair<geStatePtr, uint64_t> parsed = m_parsed.get();
+        SetState( std::move( parsed.first ), parsed.second );
+    }
+    if( !m_process ) return;
+    m_polling = true;
+    char buf[65536];
+    wxInputStream* in = m_process->GetInputStream();
+    while( in && in->CanRead() ) {
+        in->Read( buf, sizeof( buf ) );
+        if( in->LastRead() == 0 ) break;
+        m_incoming.append( buf, in->LastRead() );
+    }
+    wxInputStream* err = m_process->GetErrorStream();
+    while( err && err->CanRead() ) {
+        err->Read( buf, sizeof( buf ) );
+        if( err->LastRead() == 0 ) break;
+        m_errors.append( buf, err->LastRead() );
+    }
+
+    size_t pos = 0;
+    for( ;; ) {
+        size_t eol = m_incoming.find( '\n', pos );
+        if( eol == std::string::npos ) break;
+        size_t space = m_incoming.find( ' ', pos );
+        if( space == std::string::npos || space > eol ) {
+            pos = eol + 1; // Not a message header, skip it.
+            continue;
+        }
+        size_t size = std::strtoull( m_incoming.c_str() + space + 1, nullptr, 10 );
+        if( m_incoming.size() - ( eol + 1 ) < size ) break;
+        std::string name = m_incoming.substr( pos, space - pos );
+        std::string payload = m_incoming.substr( eol + 1, size );
+        pos = eol + 1 + size;
+        HandleMessage( name, payload );
+        if( !m_process ) break;
+    }
+    m_incoming.erase( 0, pos );
+    m_polling = false;
+}
+
+void geSession::HandleMessage( const std::string& name, const std::string& payload )
+{
+    if( name == "OUTPUT" ) {
+        m_output = payload;
+    }
+    else if( name == "PROFILE" ) {
+        if( !geParseProfile( payload, m_profile ) ) {
+            m_profile.clear();
+        }
+    }
+    else if( name == "DONE" ) {
+        std::sscanf( payload.c_str(), "%lf %lf %lf %zu",
+            &m_stats.wall, &m_stats.user, &m_stats.system, &m_stats.peakRssDelta );
+    }
+    else if( name == "STATE" ) {
+        // Large states take a while to parse, so the GUI carries on until
+        // Poll finds this done. Nothing else is sent until then.
+        m_parsed = std::async( std::launch::async, [payload]() {
+            auto state = std::make_shared<geState>();
+            if( !geState::Parse( payload, *state ) ) {
+                *state = geState();
+            }
+            uint64_t hash = state->Hash();
+            return std::make_pair( geStatePtr( std::move( state ) ), hash );
+        } );
+    }
+    else if( name == "VALUE" ) {
+        if( !m_valueReplies.empty() ) {
+            ValueFunc reply = std::move( m_valueReplies.front() );
+            m_valueReplies.pop_front();
+            reply( payload );
+        }
+    }
+    else if( name == "INPUT" ) {
+        m_stats.interactive = true;
+        m_waitingForInput = true;
+        if( m_cancelled ) {
+            Answer( std::string() );
+        }
+        else {
+            m_input( this, payload );
+        }
+    }
+}
+
+void geSession::SetState( geStatePtr state, uint64_t hash )
+{
+    m_state = std::move( state );
+    m_stateHash = hash;
+    if( m_process ) {
+        if( m_starting ) {
+            m_starting = false;
+            if( m_busy ) {
+                m_startStateHash = m_stateHash;
+                Send( "PATHS", m_pendingPaths );
+                Send( m_profiling ? "PROFILE" : "RUN", m_pendingScript );
+                m_pendingPaths.clear();
+                m_pendingScript.clear();
+            }
+        }
+        else if( m_busy ) {
+            Finish();
+        }
+    }
+}
+
+void geSession::Finish()
+{
+    m_busy = false;
+    m_output += m_errors;
+    m_errors.clear();
+    m_stats.CountOutput( m_output );
+    m_stats.cancelled = m_cancelled;
+    m_done( this, m_stats );
+}
+
+// The process has exited, either because it was cancelled or because it
+// failed. Its interpreter state has gone with it.
+void geSession::OnProcessEnded()
+{
+    bool polling = m_polling;
+    m_polling = false;
+    Poll();
+    m_polling = polling;
+    m_process = nullptr;
+    m_pid = 0;
+    m_starting = false;
+    m_waitingForInput = false;
+    m_valueReplies.clear();
+    if( m_parsed.valid() ) {
+        m_parsed.wait();
+        m_parsed = {};
+    }
+    m_state = std::make_shared<const geState>();
+    m_stateHash = m_state->Hash();
+    if( m_busy ) {
+        if( !m_cancelled ) {
+            m_errors += "\nThe session ended unexpectedly.\n";
+        }
+        Finish();
+    }
+}
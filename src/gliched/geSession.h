@@ -0,0 +1,149 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geSession.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Interpreter session in a child process header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include "geProfile.h"
+#include "geRunCache.h"
+#include "geRunStats.h"
+#include "geState.h"
+
+#include <wx/string.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+// An interpreter running in its own gliched_run --session process, so that
+// it keeps its own state and can run at the same time as other sessions.
+// All calls are made on the GUI thread, and Poll must be called regularly
+// while the session is busy. The state the process sends is parsed on a
+// worker thread, and the run is finished by the Poll that finds it done.
+class geSession
+{
+public:
+    // Called from Poll when a run has finished, or the process has ended.
+    using DoneFunc = std::function<void( geSession* session, const geRunStats& stats )>;
+    // Called from Poll when the script asks for input. It must not wait for
+    // the answer, which is given later with Answer.
+    using InputFunc = std::function<void( geSession* session, const std::string& prompt )>;
+    // Called from Poll with a value asked for by RequestValue.
+    using ValueFunc = std::function<void( const std::string& value )>;
+
+    geSession( const wxString& command, DoneFunc done, InputFunc input );
+    ~geSession();
+
+    // Start the process now, so that the library is loaded before the
+    // first run.
+    bool Start();
+    bool IsStarted() const { return m_process != nullptr; }
+
+    // Start the process if needed and send it the script to run. A profiled
+    // run times each top level statement, as geProfileScript.
+    bool Run( const std::string& script, const std::vector<std::string>& modulePaths, bool profile = false );
+    // Stop the run by ending the process, which loses the session state.
+    // Returns false if the process could not be killed.
+    bool Cancel();
+    void Poll();
+    // Ask for the full value of a row that was cut short in the state.
+    // Only possible while the session is idle.
+    bool RequestValue( const geStateRowKey& key, ValueFunc reply );
+    // Answer the script's request for input.
+    void Answer( const std::string& text );
+    bool IsWaitingForInput() const { return m_waitingForInput; }
+
+    // Unique to each session, so that a later call can check that a session
+    // is still the one it was.
+    uint64_t GetId() const { return m_id; }
+
+    bool IsBusy() const { return m_busy; }
+    // True once the current run has been cancelled.
+    bool IsCancelled() const { return m_cancelled; }
+    // True until the process has reported the state after loading the
+    // library. Poll must be called until then too.
+    bool IsStarting() const { return m_starting; }
+    bool NeedsPolling() const { return m_busy || m_starting || !m_valueReplies.empty(); }
+    const std::string& GetOutput() const { return m_output; }
+    // True if the last run was profiled, which gives its profile.
+    bool IsProfiling() const { return m_profiling; }
+    const geProfile& GetProfile() const { return m_profile; }
+    geStatePtr GetState() const { return m_state; }
+    uint64_t GetStateHash() const { return m_stateHash; }
+    // The state hash when the last run started.
+    uint64_t GetStartStateHash() const { return m_startStateHash; }
+
+    // The result cache key of the current run. Kept for the owner.
+    const geRunKey& GetRunKey() const { return m_runKey; }
+    void SetRunKey( geRunKey key ) { m_runKey = std::move( key ); }
+
+    wxString GetName() const { return m_name; }
+    void SetName( const wxString& name ) { m_name = name; }
+
+private:
+    class Process;
+
+    bool Kill();
+    void Send( const std::string& name, const std::string& payload );
+    void HandleMessage( const std::string& name, const std::string& payload );
+    void SetState( geStatePtr state, uint64_t hash );
+    void Finish();
+    void OnProcessEnded();
+
+    wxString m_command;
+    DoneFunc m_done;
+    InputFunc m_input;
+    Process* m_process;
+    long m_pid;
+    wxString m_name;
+
+    std::string m_incoming;  // Received, not yet handled.
+    std::string m_errors;    // Received on stderr during the run.
+    std::string m_pendingPaths;  // Run requested while starting.
+    std::string m_pendingScript;
+    bool m_busy;
+    bool m_starting;
+    bool m_cancelled;
+    bool m_polling;
+    bool m_waitingForInput;
+    bool m_profiling;
+    uint64_t m_id;
+    geRunStats m_stats;
+    std::string m_output;
+    geProfile m_profile;
+    geStatePtr m_state;
+    uint64_t m_stateHash;
+    std::future<std::pair<geStatePtr, uint64_t>> m_parsed; // A STATE being parsed.
+    std::deque<ValueFunc> m_valueReplies; // Waiting for VALUE, in the order asked.
+    uint64_t m_startStateHash;
+    geRunKey m_runKey;
+
+    static std::atomic<uint64_t> s_lastId;
+};
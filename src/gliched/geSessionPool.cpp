@@ -0,0 +1,153 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geSessionPool.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Pool of interpreter sessions.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "geSessionPool.h"
+
+#include <algorithm>
+
+geSession* geSessionPool::Get( const void* owner )
+{
+    for( Entry& entry : m_entries ) {
+        if( entry.owner == owner ) {
+            entry.lastUsed = ++m_useCount;
+            return entry.session.get();
+        }
+    }
+    if( m_command.empty() ) {
+        return nullptr;
+    }
+    if( m_entries.size() >= m_maxSessions ) {
+        auto oldest = m_entries.end();
+        for( auto it = m_entries.begin(); it != m_entries.end(); ++it ) {
+            if( !it->session->IsBusy() && ( oldest == m_entries.end() || it->lastUsed < oldest->lastUsed ) ) {
+                oldest = it;
+            }
+        }
+        if( oldest == m_entries.end() ) {
+            return nullptr;
+        }
+        Closing( oldest->session.get() );
+        m_entries.erase( oldest );
+    }
+    m_entries.push_back( { owner, TakeSpare(), ++m_useCount } );
+    return m_entries.back().session.get();
+}
+
+geSession* geSessionPool::Find( const void* owner ) const
+{
+    for( const Entry& entry : m_entries ) {
+        if( entry.owner == owner ) {
+            return entry.session.get();
+        }
+    }
+    return nullptr;
+}
+
+geSession* geSessionPool::FindById( uint64_t id ) const
+{
+    for( const Entry& entry : m_entries ) {
+        if( entry.session->GetId() == id ) {
+            return entry.session.get();
+        }
+    }
+    return nullptr;
+}
+
+geSession* geSessionPool::Reset( const void* owner )
+{
+    for( Entry& entry : m_entries ) {
+        if( entry.owner == owner ) {
+            Closing( entry.session.get() );
+            entry.session = TakeSpare();
+            entry.lastUsed = ++m_useCount;
+            return entry.session.get();
+        }
+    }
+    return Get( owner );
+}
+
+void geSessionPool::Prepare()
+{
+    if( m_command.empty() ) {
+        return;
+    }
+    if( !m_spare ) {
+        m_spare = std::make_unique<geSession>( m_command, m_done, m_input );
+    }
+    if( !m_spare->IsStarted() ) {
+        m_spare->Start();
+    }
+}
+
+// Hand over the spare session and start another in its place. The new
+// process loads the library while the handed over one is in use.
+std::unique_ptr<geSession> geSessionPool::TakeSpare()
+{
+    Prepare();
+    std::unique_ptr<geSession> session = std::move( m_spare );
+    Prepare();
+    return session;
+}
+
+void geSessionPool::Release( const void* owner )
+{
+    auto it = std::find_if( m_entries.begin(), m_entries.end(),
+        [owner]( const Entry& entry ) { return entry.owner == owner; } );
+    if( it != m_entries.end() ) {
+        Closing( it->session.get() );
+        m_entries.erase( it );
+    }
+}
+
+void geSessionPool::Closing( geSession* session ) const
+{
+    if( m_closed ) {
+        m_closed( session );
+    }
+}
+
+void geSessionPool::Poll()
+{
+    for( Entry& entry : m_entries ) {
+        entry.session->Poll();
+    }
+    if( m_spare ) {
+        m_spare->Poll();
+    }
+}
+
+bool geSessionPool::IsBusy() const
+{
+    return std::any_of( m_entries.begin(), m_entries.end(),
+        []( const Entry& entry ) { return entry.session->IsBusy(); } );
+}
+
+bool geSessionPool::NeedsPolling() const
+{
+    return ( m_spare && m_spare->NeedsPolling() )
+        || std::any_of( m_entries.begin(), m_entries.end(),
+            []( const Entry& entry ) { return entry.session->NeedsPolling(); } );
+}
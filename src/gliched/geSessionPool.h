@@ -0,0 +1,92 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geSessionPool.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Pool of interpreter sessions header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include "geSession.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Keeps one geSession for each owner, usually an editor tab. When the pool
+// is full the session least recently used by an idle owner is closed to
+// make room for a new one. A spare session is kept started, with its
+// library loaded, so that a new or reset session is ready at once.
+class geSessionPool
+{
+public:
+    // Called just before a session is destroyed, whether it is closed to
+    // make room, replaced by Reset or released, so that the owner can drop
+    // any pointer it holds to it.
+    using ClosedFunc = std::function<void( geSession* session )>;
+
+    geSessionPool( size_t maxSessions, geSession::DoneFunc done, geSession::InputFunc input, ClosedFunc closed )
+        : m_maxSessions( maxSessions ), m_done( done ), m_input( input ), m_closed( closed ), m_useCount( 0 ) {}
+
+    // Sessions are run with command. If it is empty there are no sessions.
+    void SetCommand( const wxString& command ) { m_command = command; }
+    bool IsAvailable() const { return !m_command.empty(); }
+
+    // Find or create the session for owner. Returns nullptr if the pool is
+    // full and every session is busy.
+    geSession* Get( const void* owner );
+    geSession* Find( const void* owner ) const;
+    geSession* FindById( uint64_t id ) const;
+    void Release( const void* owner );
+
+    // Replace the session for owner with a fresh one, in the state left by
+    // loading the library. Returns nullptr if there are no sessions.
+    geSession* Reset( const void* owner );
+
+    // Start the spare session, if it is not already started.
+    void Prepare();
+
+    void Poll();
+    bool IsBusy() const;
+    // True while any session, including the spare, needs polling.
+    bool NeedsPolling() const;
+
+private:
+    std::unique_ptr<geSession> TakeSpare();
+    void Closing( geSession* session ) const;
+
+    struct Entry
+    {
+        const void* owner;
+        std::unique_ptr<geSession> session;
+        unsigned long lastUsed;
+    };
+
+    size_t m_maxSessions;
+    geSession::DoneFunc m_done;
+    geSession::InputFunc m_input;
+    ClosedFunc m_closed;
+    wxString m_command;
+    std::vector<Entry> m_entries;
+    std::unique_ptr<geSession> m_spare;
+    unsigned long m_useCount;
+};
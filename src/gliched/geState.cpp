@@ -0,0 +1,262 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geState.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Snapshot of the Glich interpreter state.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "geState.h"
+
+#include "geHash.h"
+
+#include <glc/hic.h>
+
+#include <cstdlib>
+
+// Call func( label, typed, list ) for each list of a mark, in the order
+// they are shown.
+template<typename Data, typename Func>
+static void ForEachList( const Data& data, Func func )
+{
+    func( "object", false, data.glc.obj );
+    func( "file", false, data.glc.file );
+    func( "function", false, data.glc.fun );
+    func( "command", false, data.glc.com );
+    func( "lexicon", false, data.lex );
+    func( "grammar", false, data.gmr );
+    func( "format", false, data.fmt );
+    func( "scheme", false, data.sch );
+    func( "variables", true, data.glc.var );
+    func( "globals", true, data.glc.global );
+    func( "constants", true, data.glc.constant );
+}
+
+// Only typed lists have items with a type.
+template<typename Item>
+static auto ItemType( const Item& item, int ) -> decltype( std::string_view( item.type ) )
+{
+    return item.type;
+}
+
+template<typename Item>
+static std::string_view ItemType( const Item&, long )
+{
+    return std::string_view();
+}
+
+geState geState::Capture()
+{
+    geState state;
+    for( const auto& data : glich::hic().get_hic_data() ) {
+        geStateMark mark;
+        mark.name = data.glc.name;
+        ForEachList( data, [&mark]( const char* label, bool typed, const auto& list ) {
+            if( !list.empty() ) {
+                geStateCategory cat{ geAtom( label ), typed, {} };
+                cat.rows.reserve( list.size() );
+                for( const auto& item : list ) {
+                    cat.rows.push_back( MakeRow( ItemType( item, 0 ), item.name, item.value ) );
+                }
+                mark.categories.push_back( std::move( cat ) );
+            }
+        } );
+        state.m_marks.push_back( std::move( mark ) );
+    }
+    return state;
+}
+
+bool geState::FindValue( const geStateRowKey& key, std::string& value )
+{
+    bool found = false;
+    for( const auto& data : glich::hic().get_hic_data() ) {
+        if( data.glc.name != key.mark ) {
+            continue;
+        }
+        ForEachList( data, [&]( const char* label, bool, const auto& list ) {
+            if( found || key.category != label ) {
+                return;
+            }
+            for( const auto& item : list ) {
+                if( item.name == key.name ) {
+                    value = item.value;
+                    found = true;
+                    return;
+                }
+            }
+        } );
+        break;
+    }
+    return found;
+}
+
+geStateRow geState::MakeRow( std::string_view type, std::string_view name, std::string_view value )
+{
+    uint64_t fullHash = 0;
+    if( value.size() > MaxValueSize ) {
+        geHasher hasher;
+        hasher.Add( value );
+        fullHash = hasher.Get() | 1;
+        size_t size = MaxValueSize;
+        while( size > 0 && ( static_cast<unsigned char>( value[size] ) & 0xC0 ) == 0x80 ) {
+            size--;
+        }
+        value = value.substr( 0, size );
+    }
+    return { geAtom( type ), geAtom( name ), geAtom( value ), fullHash };
+}
+
+uint64_t geState::Hash() const
+{
+    geHasher hasher;
+    hasher.Add( m_marks.size() );
+    for( const geStateMark& mark : m_marks ) {
+        hasher.Add( mark.name );
+        hasher.Add( mark.categories.size() );
+        for( const geStateCategory& cat : mark.categories ) {
+            hasher.Add( cat.label );
+            hasher.Add( cat.rows.size() );
+            for( const geStateRow& row : cat.rows ) {
+                hasher.Add( row.type );
+                hasher.Add( row.name );
+                hasher.Add( row.value );
+                hasher.Add( row.fullHash );
+            }
+        }
+    }
+    return hasher.Get();
+}
+
+static void AddField( std::string& out, std::string_view field )
+{
+    out += '\t';
+    for( char ch : field ) {
+        switch( ch ) {
+        case '\\': out += "\\\\"; break;
+        case '\t': out += "\\t"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        default: out += ch;
+        }
+    }
+}
+
+// Split a record into its fields, undoing the escapes.
+static std::vector<std::string> SplitFields( std::string_view line )
+{
+    std::vector<std::string> fields( 1 );
+    for( size_t i = 0; i < line.size(); i++ ) {
+        char ch = line[i];
+        if( ch == '\t' ) {
+            fields.emplace_back();
+        }
+        else if( ch == '\\' && i + 1 < line.size() ) {
+            switch( line[++i] ) {
+            case 't': fields.back() += '\t'; break;
+            case 'n': fields.back() += '\n'; break;
+            case 'r': fields.back() += '\r'; break;
+            default: fields.back() += line[i];
+            }
+        }
+        else {
+            fields.back() += ch;
+        }
+    }
+    return fields;
+}
+
+// Records are "M name" for a mark, "C label typed" for a category of the
+// last mark, and "R type name value" for a row of the last category. A
+// value that was cut short is followed by the hash of the full value.
+std::string geState::Serialize() const
+{
+    std::string out;
+    for( const geStateMark& mark : m_marks ) {
+        out += 'M';
+        AddField( out, mark.name );
+        out += '\n';
+        for( const geStateCategory& cat : mark.categories ) {
+            out += 'C';
+            AddField( out, cat.label );
+            AddField( out, cat.typed ? "1" : "0" );
+            out += '\n';
+            for( const geStateRow& row : cat.rows ) {
+                out += 'R';
+                AddField( out, row.type );
+                AddField( out, row.name );
+                AddField( out, row.value );
+                if( row.IsTruncated() ) {
+                    AddField( out, geHasher::ToHex( row.fullHash ) );
+                }
+                out += '\n';
+            }
+        }
+    }
+    return out;
+}
+
+bool geState::Parse( std::string_view text, geState& state )
+{
+    state.m_marks.clear();
+    while( !text.empty() ) {
+        size_t end = text.find( '\n' );
+        std::vector<std::string> fields = SplitFields( text.substr( 0, end ) );
+        text.remove_prefix( end == text.npos ? text.size() : end + 1 );
+
+        const std::string& kind = fields[0];
+        if( kind == "M" && fields.size() == 2 ) {
+            state.m_marks.push_back( { fields[1], {} } );
+        }
+        else if( kind == "C" && fields.size() == 3 && !state.m_marks.empty() ) {
+            state.m_marks.back().categories.push_back( { geAtom( fields[1] ), fields[2] == "1", {} } );
+        }
+        else if( kind == "R" && ( fields.size() == 4 || fields.size() == 5 )
+            && !state.m_marks.empty() && !state.m_marks.back().categories.empty() )
+        {
+            uint64_t fullHash = fields.size() == 5 ? std::strtoull( fields[4].c_str(), nullptr, 16 ) : 0;
+            state.m_marks.back().categories.back().rows.push_back(
+                { geAtom( fields[1] ), geAtom( fields[2] ), geAtom( fields[3] ), fullHash } );
+        }
+        else {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string geState::SerializeKey( const geStateRowKey& key )
+{
+    std::string out = "K";
+    AddField( out, key.mark );
+    AddField( out, key.category );
+    AddField( out, key.name );
+    return out;
+}
+
+bool geState::ParseKey( std::string_view text, geStateRowKey& key )
+{
+    std::vector<std::string> fields = SplitFields( text );
+    if( fields.size() != 4 || fields[0] != "K" ) {
+        return false;
+    }
+    key = { fields[1], fields[2], fields[3] };
+    return true;
+}
@@ -0,0 +1,106 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geState.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Snapshot of the Glich interpreter state header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include "geAtom.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A copy of the interpreter state, as shown in the Glich State pane,
+// that can be held and compared without the interpreter. Row strings are
+// atoms, so successive snapshots share the text that hasn't changed, and
+// long values are cut short. The full value can be found with FindValue.
+struct geStateRow
+{
+    geAtom type;        // Empty for categories without types.
+    geAtom name;
+    geAtom value;
+    uint64_t fullHash;  // Hash of the whole value if it was cut short, else 0.
+
+    bool IsTruncated() const { return fullHash != 0; }
+};
+
+struct geStateCategory
+{
+    geAtom label;
+    bool typed;         // Rows have a type column.
+    std::vector<geStateRow> rows;
+};
+
+struct geStateMark
+{
+    std::string name;   // Empty for the root.
+    std::vector<geStateCategory> categories;
+};
+
+// Identifies a row, to ask for its full value.
+struct geStateRowKey
+{
+    std::string mark;
+    std::string category;
+    std::string name;
+};
+
+class geState
+{
+public:
+    // Values are kept to about this many bytes, without splitting a UTF-8
+    // sequence.
+    static constexpr size_t MaxValueSize = 256;
+
+    geState() {}
+    explicit geState( std::vector<geStateMark> marks ) : m_marks( std::move( marks ) ) {}
+
+    // Take a snapshot of glich::hic(). Categories with no rows are left out.
+    static geState Capture();
+    // Find the full value of a row of glich::hic().
+    static bool FindValue( const geStateRowKey& key, std::string& value );
+
+    static geStateRow MakeRow( std::string_view type, std::string_view name, std::string_view value );
+
+    const std::vector<geStateMark>& GetMarks() const { return m_marks; }
+    uint64_t Hash() const;
+
+    // A text form of the state, for passing between processes. Each line
+    // is a record of tab separated fields, with tab, newline and backslash
+    // escaped in the values.
+    std::string Serialize() const;
+    static bool Parse( std::string_view text, geState& state );
+    static std::string SerializeKey( const geStateRowKey& key );
+    static bool ParseKey( std::string_view text, geStateRowKey& key );
+
+private:
+    std::vector<geStateMark> m_marks;
+};
+
+// States are shared, unchanged, between the thread that made them and the
+// State pane.
+using geStatePtr = std::shared_ptr<const geState>;
@@ -0,0 +1,121 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geStateIndex.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Text index of a Glich state for the State pane filter.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+
+ */
+
+#include "geStateIndex.h"
+
+#include <algorithm>
+
+geStateIndex::geStateIndex( geStatePtr state )
+    : m_state( std::move( state ) )
+{
+    const std::vector<geStateMark>& marks = m_state->GetMarks();
+    for( uint32_t m = 0; m < marks.size(); m++ ) {
+        const std::vector<geStateCategory>& cats = marks[m].categories;
+        for( uint32_t c = 0; c < cats.size(); c++ ) {
+            const std::vector<geStateRow>& rows = cats[c].rows;
+            for( uint32_t r = 0; r < rows.size(); r++ ) {
+                m_entries.push_back( { m, c, r, static_cast<uint32_t>( m_text.size() ) } );
+                m_text += Lower( rows[r].name );
+                m_text += '\0';
+                m_text += Lower( rows[r].value );
+                m_text += '\0';
+            }
+        }
+    }
+}
+
+const std::vector<uint32_t>& geStateIndex::Find( std::string_view text )
+{
+    std::string lower = Lower( text );
+    if( !m_lastText.empty() && lower.find( m_lastText ) != std::string::npos ) {
+        // Only rows that held the last text can hold this.
+        std::vector<uint32_t> found;
+        for( uint32_t entry : m_lastFound ) {
+            if( Contains( entry, lower ) ) {
+                found.push_back( entry );
+            }
+        }
+        m_lastFound = std::move( found );
+    }
+    else {
+        m_lastFound.clear();
+        size_t pos = lower.empty() ? std::string::npos : m_text.find( lower );
+        while( pos != std::string::npos ) {
+            auto it = std::upper_bound( m_entries.begin(), m_entries.end(), pos,
+                []( size_t p, const Entry& e ) { return p < e.offset; } );
+            uint32_t entry = static_cast<uint32_t>( it - m_entries.begin() ) - 1;
+            m_lastFound.push_back( entry );
+            if( it == m_entries.end() ) {
+                break;
+            }
+            pos = m_text.find( lower, it->offset );
+        }
+    }
+    m_lastText = std::move( lower );
+    return m_lastFound;
+}
+
+geState geStateIndex::Select( const std::vector<uint32_t>& rows ) const
+{
+    const std::vector<geStateMark>& marks = m_state->GetMarks();
+    std::vector<geStateMark> selected;
+    uint32_t mark = uint32_t( -1 );
+    uint32_t cat = uint32_t( -1 );
+    for( uint32_t i : rows ) {
+        const Entry& entry = m_entries[i];
+        if( entry.mark != mark ) {
+            mark = entry.mark;
+            cat = uint32_t( -1 );
+            selected.push_back( { marks[mark].name, {} } );
+        }
+        const geStateCategory& category = marks[mark].categories[entry.cat];
+        if( entry.cat != cat ) {
+            cat = entry.cat;
+            selected.back().categories.push_back( { category.label, category.typed, {} } );
+        }
+        selected.back().categories.back().rows.push_back( category.rows[entry.row] );
+    }
+    return geState( std::move( selected ) );
+}
+
+std::string geStateIndex::Lower( std::string_view text )
+{
+    std::string lower( text );
+    for( char& ch : lower ) {
+        if( ch >= 'A' && ch <= 'Z' ) {
+            ch += 'a' - 'A';
+        }
+    }
+    return lower;
+}
+
+bool geStateIndex::Contains( uint32_t entry, std::string_view text ) const
+{
+    size_t start = m_entries[entry].offset;
+    size_t end = entry + 1 < m_entries.size() ? m_entries[entry + 1].offset : m_text.size();
+    return std::string_view( m_text ).substr( start, end - start ).find( text ) != std::string_view::npos;
+}
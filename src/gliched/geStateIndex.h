@@ -0,0 +1,74 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geStateIndex.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Text index of a Glich state for the State pane filter header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+
+ */
+
+#pragma once
+
+#include "geState.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// An index of the row names and values of a state, for finding the rows
+// that contain some text. The text of every row is kept lower cased in one
+// buffer, so a search is a single pass with std::string::find. A search for
+// text that contains the last text searched for only looks at the rows
+// found last time, which is the usual case when typing into a filter.
+class geStateIndex
+{
+public:
+    geStateIndex() {}
+    explicit geStateIndex( geStatePtr state );
+
+    geStatePtr GetState() const { return m_state; }
+
+    // The rows whose name or value contains text, ignoring ASCII case.
+    const std::vector<uint32_t>& Find( std::string_view text );
+    // A state with only the given rows, and the categories and marks that
+    // hold them.
+    geState Select( const std::vector<uint32_t>& rows ) const;
+
+    static std::string Lower( std::string_view text );
+
+private:
+    struct Entry
+    {
+        uint32_t mark;
+        uint32_t cat;
+        uint32_t row;
+        uint32_t offset;    // Start of the row's text in m_text.
+    };
+
+    bool Contains( uint32_t entry, std::string_view text ) const;
+
+    geStatePtr m_state;
+    std::string m_text;     // "name\0value\0" for each row.
+    std::vector<Entry> m_entries;
+    std::string m_lastText;
+    std::vector<uint32_t> m_lastFound;
+};
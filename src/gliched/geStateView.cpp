@@ -0,0 +1,500 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geStateView.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Glich State tree view and data model.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+
+ */
+
+#include "geStateView.h"
+
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+
+    std::string_view KeyOf( const geStateMark& mark ) { return mark.name; }
+    std::string_view KeyOf( const geStateCategory& cat ) { return cat.label; }
+    std::string_view KeyOf( const geStateRow& row ) { return row.name; }
+
+    bool SameRows( const std::vector<geStateRow>& a, const std::vector<geStateRow>& b )
+    {
+        if( a.size() != b.size() ) {
+            return false;
+        }
+        for( size_t i = 0; i < a.size(); i++ ) {
+            // Atoms are compared by pointer, so this is cheap.
+            if( a[i].name != b[i].name || a[i].value != b[i].value || a[i].type != b[i].type
+                || a[i].fullHash != b[i].fullHash )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
+
+geStateModel::geStateModel()
+    : m_state( std::make_shared<geState>() ), m_fullState( m_state ), m_rowCount( 0 ), m_highlight( false )
+{
+}
+
+void geStateModel::SetState( geStatePtr state )
+{
+    m_fullState = std::move( state );
+    m_index = geStateIndex();
+    if( m_filter.empty() ) {
+        Show( m_fullState, true );
+        return;
+    }
+    m_index = geStateIndex( m_fullState );
+    Show( std::make_shared<const geState>( m_index.Select( m_index.Find( m_filter ) ) ), true );
+}
+
+void geStateModel::SetFilter( const std::string& text )
+{
+    if( text == m_filter ) {
+        return;
+    }
+    m_filter = text;
+    if( m_filter.empty() ) {
+        Show( m_fullState, false );
+        return;
+    }
+    if( m_index.GetState() != m_fullState ) {
+        m_index = geStateIndex( m_fullState );
+    }
+    Show( std::make_shared<const geState>( m_index.Select( m_index.Find( m_filter ) ) ), false );
+}
+
+void geStateModel::Show( geStatePtr state, bool highlight )
+{
+    // The old state is kept until the merge is done, as the nodes point into it.
+    geStatePtr old = std::move( m_state );
+    m_state = std::move( state );
+    m_highlight = highlight;
+    if( highlight ) {
+        ClearChanged();
+    }
+    Merge( nullptr, m_marks, m_state->GetMarks() );
+    m_rowCount = 0;
+    for( const geStateMark& mark : m_state->GetMarks() ) {
+        for( const geStateCategory& cat : mark.categories ) {
+            m_rowCount += cat.rows.size();
+        }
+    }
+}
+
+void geStateModel::Clear()
+{
+    SetState( std::make_shared<const geState>() );
+}
+
+bool geStateModel::GetTruncatedRow( const wxDataViewItem& item, geStateRowKey& key ) const
+{
+    const Node* node = ToNode( item );
+    if( !node || !node->row || !node->row->IsTruncated() ) {
+        return false;
+    }
+    key.mark = node->parent->parent->mark->name;
+    key.category = std::string( node->parent->cat->label.view() );
+    key.name = std::string( node->row->name.view() );
+    return true;
+}
+
+void geStateModel::GetCategories( wxDataViewItemArray& items ) const
+{
+    for( const std::unique_ptr<Node>& mark : m_marks ) {
+        for( const std::unique_ptr<Node>& cat : mark->children ) {
+            items.push_back( wxDataViewItem( cat.get() ) );
+        }
+    }
+}
+
+// Untyped rows have their name and value in the first two columns.
+void geStateModel::GetValue( wxVariant& variant, const wxDataViewItem& item, unsigned int col ) const
+{
+    const Node* node = ToNode( item );
+    const char* text = "";
+    if( node->mark ) {
+        if( col == 0 ) {
+            text = node->mark->name.empty() ? "root" : "mark";
+        }
+        else if( col == 1 ) {
+            text = node->mark->name.c_str();
+        }
+    }
+    else if( node->cat ) {
+        if( col == 0 ) {
+            text = node->cat->label.c_str();
+        }
+    }
+    else {
+        if( !node->parent->cat->typed ) {
+            col++;
+        }
+        switch( col )
+        {
+        case 0: text = node->row->type.c_str(); break;
+        case 1: text = node->row->name.c_str(); break;
+        case 2:
+            if( node->row->IsTruncated() ) {
+                variant = wxString::FromUTF8( node->row->value.c_str() ) + wxString::FromUTF8( u8"…" );
+                return;
+            }
+            text = node->row->value.c_str();
+            break;
+        }
+    }
+    variant = wxString::FromUTF8( text );
+}
+
+bool geStateModel::SetValue( const wxVariant&, const wxDataViewItem&, unsigned int )
+{
+    return false;
+}
+
+// Changed rows are coloured, and the marks and categories holding them are
+// bold so that changes can be found while they are collapsed.
+bool geStateModel::GetAttr( const wxDataViewItem& item, unsigned int, wxDataViewItemAttr& attr ) const
+{
+    const Node* node = ToNode( item );
+    if( !node || !node->changed ) {
+        return false;
+    }
+    attr.SetBold( true );
+    if( node->row ) {
+        attr.SetColour( wxColour( 0xC0, 0x40, 0x00 ) );
+    }
+    return true;
+}
+
+wxDataViewItem geStateModel::GetParent( const wxDataViewItem& item ) const
+{
+    const Node* node = ToNode( item );
+    if( !node || !node->parent ) {
+        return wxDataViewItem();
+    }
+    return wxDataViewItem( node->parent );
+}
+
+bool geStateModel::IsContainer( const wxDataViewItem& item ) const
+{
+    const Node* node = ToNode( item );
+    return !node || node->mark || node->cat;
+}
+
+unsigned int geStateModel::GetChildren( const wxDataViewItem& item, wxDataViewItemArray& children ) const
+{
+    Node* node = ToNode( item );
+    const NodeVec* nodes = &m_marks;
+    if( node ) {
+        if( !node->populated ) {
+            node->children.reserve( node->cat->rows.size() );
+            for( const geStateRow& row : node->cat->rows ) {
+                node->children.push_back( MakeNode( node, row ) );
+            }
+            node->populated = true;
+        }
+        nodes = &node->children;
+    }
+    for( const std::unique_ptr<Node>& child : *nodes ) {
+        children.push_back( wxDataViewItem( child.get() ) );
+    }
+    return nodes->size();
+}
+
+std::unique_ptr<geStateModel::Node> geStateModel::MakeNode( Node* parent, const geStateMark& mark )
+{
+    std::unique_ptr<Node> node( new Node{ parent, &mark, nullptr, nullptr, {}, true, false } );
+    for( const geStateCategory& cat : mark.categories ) {
+        node->children.push_back( MakeNode( node.get(), cat ) );
+    }
+    return node;
+}
+
+std::unique_ptr<geStateModel::Node> geStateModel::MakeNode( Node* parent, const geStateCategory& cat )
+{
+    return std::unique_ptr<Node>( new Node{ parent, nullptr, &cat, nullptr, {}, false, false } );
+}
+
+std::unique_ptr<geStateModel::Node> geStateModel::MakeNode( Node* parent, const geStateRow& row )
+{
+    return std::unique_ptr<Node>( new Node{ parent, nullptr, nullptr, &row, {}, true, false } );
+}
+
+// Bring the children of parent into line with items, telling the view of
+// each removal and addition. Nodes are matched by key. If the nodes that
+// are kept have changed order, all are replaced, as the view can't be told
+// of a move. Returns true if anything under parent changed.
+template<typename T>
+bool geStateModel::Merge( Node* parent, NodeVec& children, const std::vector<T>& items )
+{
+    const size_t none = size_t( -1 );
+    std::vector<size_t> match( items.size(), none );
+
+    // Usually the keys are unchanged, so try that before building an index.
+    size_t first = 0;
+    while( first < items.size() && first < children.size()
+        && NodeKey( children[first].get() ) == KeyOf( items[first] ) )
+    {
+        match[first] = first;
+        first++;
+    }
+    if( first < items.size() ) {
+        std::unordered_map<std::string_view, size_t> index;
+        for( size_t i = first; i < children.size(); i++ ) {
+            index.emplace( NodeKey( children[i].get() ), i );
+        }
+        bool ordered = true;
+        size_t next = first;
+        for( size_t i = first; i < items.size() && !index.empty(); i++ ) {
+            auto it = index.find( KeyOf( items[i] ) );
+            if( it != index.end() ) {
+                ordered = ordered && it->second >= next;
+                next = it->second + 1;
+                match[i] = it->second;
+                index.erase( it );
+            }
+        }
+        if( !ordered ) {
+            std::fill( match.begin() + first, match.end(), none );
+        }
+    }
+
+    std::vector<bool> kept( children.size(), false );
+    for( size_t i : match ) {
+        if( i != none ) {
+            kept[i] = true;
+        }
+    }
+    wxDataViewItem parentItem( parent );
+    wxDataViewItemArray removed;
+    NodeVec removedNodes;
+    NodeVec survivors;
+    for( size_t i = 0; i < children.size(); i++ ) {
+        if( kept[i] ) {
+            survivors.push_back( std::move( children[i] ) );
+        }
+        else {
+            removed.push_back( wxDataViewItem( children[i].get() ) );
+            removedNodes.push_back( std::move( children[i] ) );
+        }
+    }
+    children = std::move( survivors );
+    if( !removed.empty() ) {
+        ItemsDeleted( parentItem, removed );
+        for( const std::unique_ptr<Node>& node : removedNodes ) {
+            ForgetChanged( node.get() );
+        }
+        removedNodes.clear();
+    }
+
+    NodeVec merged;
+    merged.reserve( items.size() );
+    std::vector<std::pair<Node*, const T*>> updates;
+    wxDataViewItemArray added;
+    size_t survivor = 0;
+    for( size_t i = 0; i < items.size(); i++ ) {
+        if( match[i] != none ) {
+            merged.push_back( std::move( children[survivor++] ) );
+            updates.push_back( { merged.back().get(), &items[i] } );
+        }
+        else {
+            merged.push_back( MakeNode( parent, items[i] ) );
+            if( m_highlight ) {
+                merged.back()->changed = true;
+                m_changed.insert( merged.back().get() );
+            }
+            added.push_back( wxDataViewItem( merged.back().get() ) );
+        }
+    }
+    children = std::move( merged );
+    if( !added.empty() ) {
+        ItemsAdded( parentItem, added );
+    }
+
+    bool changed = !removed.empty() || !added.empty();
+    for( const auto& update : updates ) {
+        if( Update( update.first, *update.second ) ) {
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool geStateModel::Update( Node* node, const geStateMark& mark )
+{
+    node->mark = &mark;
+    bool changed = Merge( node, node->children, mark.categories );
+    if( changed ) {
+        MarkChanged( node );
+    }
+    return changed;
+}
+
+// The rows of a category the view has not asked for are only compared.
+bool geStateModel::Update( Node* node, const geStateCategory& cat )
+{
+    const geStateCategory* old = node->cat;
+    node->cat = &cat;
+    bool changed = node->populated ? Merge( node, node->children, cat.rows ) : !SameRows( old->rows, cat.rows );
+    if( changed ) {
+        MarkChanged( node );
+    }
+    return changed;
+}
+
+bool geStateModel::Update( Node* node, const geStateRow& row )
+{
+    const geStateRow* old = node->row;
+    node->row = &row;
+    bool changed = old->value != row.value || old->type != row.type || old->fullHash != row.fullHash;
+    if( changed ) {
+        MarkChanged( node );
+    }
+    return changed;
+}
+
+std::string_view geStateModel::NodeKey( const Node* node )
+{
+    if( node->mark ) {
+        return node->mark->name;
+    }
+    if( node->cat ) {
+        return node->cat->label;
+    }
+    return node->row->name;
+}
+
+// Only a new state is highlighted, not a new filter.
+void geStateModel::MarkChanged( Node* node )
+{
+    if( m_highlight ) {
+        node->changed = true;
+        m_changed.insert( node );
+        ItemChanged( wxDataViewItem( node ) );
+    }
+}
+
+void geStateModel::ForgetChanged( Node* node )
+{
+    if( node->changed ) {
+        m_changed.erase( node );
+    }
+    for( const std::unique_ptr<Node>& child : node->children ) {
+        ForgetChanged( child.get() );
+    }
+}
+
+void geStateModel::ClearChanged()
+{
+    wxDataViewItemArray items;
+    for( Node* node : m_changed ) {
+        node->changed = false;
+        items.push_back( wxDataViewItem( node ) );
+    }
+    m_changed.clear();
+    if( !items.empty() ) {
+        ItemsChanged( items );
+    }
+}
+
+geStateView::geStateView( wxWindow* parent, wxWindowID id, const wxSize& size )
+    : wxDataViewCtrl( parent, id, wxDefaultPosition, size, wxDV_MULTIPLE | wxDV_ROW_LINES ),
+    m_model( new geStateModel ), m_tipRequest( 0 )
+{
+    AssociateModel( m_model.get() );
+    GetMainWindow()->Bind( wxEVT_MOTION, &geStateView::OnMouseMove, this );
+    GetMainWindow()->Bind( wxEVT_LEAVE_WINDOW, &geStateView::OnMouseLeave, this );
+
+    // Fixed widths, as sizing a column to its contents would visit every row.
+    AppendTextColumn( "Type", 0, wxDATAVIEW_CELL_INERT, 100, wxALIGN_LEFT, wxDATAVIEW_COL_RESIZABLE );
+    AppendTextColumn( "Name", 1, wxDATAVIEW_CELL_INERT, 120, wxALIGN_LEFT, wxDATAVIEW_COL_RESIZABLE );
+    AppendTextColumn( "Value", 2, wxDATAVIEW_CELL_INERT, 200, wxALIGN_LEFT, wxDATAVIEW_COL_RESIZABLE );
+}
+
+void geStateView::SetState( geStatePtr state )
+{
+    ResetTip();
+    m_model->SetState( std::move( state ) );
+}
+
+// Matches are shown expanded, unless there are too many to look through.
+void geStateView::SetFilter( const wxString& text )
+{
+    constexpr size_t maxExpandRows = 500;
+    ResetTip();
+    m_model->SetFilter( text.utf8_string() );
+    if( !text.empty() && m_model->GetRowCount() <= maxExpandRows ) {
+        wxDataViewItemArray cats;
+        m_model->GetCategories( cats );
+        for( const wxDataViewItem& cat : cats ) {
+            Expand( cat );
+        }
+    }
+}
+
+void geStateView::OnMouseMove( wxMouseEvent& evt )
+{
+    evt.Skip();
+    wxDataViewItem item;
+    wxDataViewColumn* column = nullptr;
+    HitTest( ScreenToClient( GetMainWindow()->ClientToScreen( evt.GetPosition() ) ), item, column );
+    if( item == m_tipItem ) {
+        return;
+    }
+    ResetTip();
+    m_tipItem = item;
+    geStateRowKey key;
+    if( !m_valueFunc || !m_model->GetTruncatedRow( item, key ) ) {
+        return;
+    }
+    constexpr size_t maxTipLength = 4000;
+    uint64_t request = m_tipRequest;
+    m_valueFunc( key, [this, request]( const std::string& value ) {
+        if( request != m_tipRequest || value.empty() ) {
+            return;
+        }
+        wxString tip = wxString::FromUTF8( value );
+        if( tip.length() > maxTipLength ) {
+            tip = tip.Left( maxTipLength ) + wxString::FromUTF8( u8"…" );
+        }
+        GetMainWindow()->SetToolTip( tip );
+    } );
+}
+
+void geStateView::OnMouseLeave( wxMouseEvent& evt )
+{
+    evt.Skip();
+    ResetTip();
+}
+
+// Items are invalid once the state changes, so forget the hovered one.
+void geStateView::ResetTip()
+{
+    m_tipRequest++;
+    m_tipItem = wxDataViewItem();
+    GetMainWindow()->UnsetToolTip();
+}
@@ -0,0 +1,153 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched/geStateView.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Glich State tree view and data model header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+
+ */
+
+#pragma once
+
+#include "geState.h"
+#include "geStateIndex.h"
+
+#include <wx/dataview.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// A virtual model of a geState for the Glich State pane. Marks and their
+// categories are known up front, but the rows of a category only get a
+// node when the view first asks for them, which it does when the category
+// is expanded. So the cost of showing a new state follows what is visible,
+// not the size of the state.
+//
+// States are never changed once made, so the model keeps the one it is
+// given rather than a copy.
+//
+// A new state is merged into the nodes the view already has, matching
+// marks by name, categories by label and rows by name. Only nodes that
+// were added, removed or changed are passed on to the view, so expanded
+// nodes and the scroll position are kept. Changed nodes are highlighted
+// until the next state is set.
+//
+// A filter shows only the rows whose name or value contains its text. The
+// filtered state is merged in the same way, without highlighting.
+class geStateModel : public wxDataViewModel
+{
+public:
+    geStateModel();
+
+    void SetState( geStatePtr state );
+    void SetFilter( const std::string& text );
+    void Clear();
+
+    // The categories shown, for expanding them.
+    void GetCategories( wxDataViewItemArray& items ) const;
+    size_t GetRowCount() const { return m_rowCount; }
+    // The key of a row whose value was cut short.
+    bool GetTruncatedRow( const wxDataViewItem& item, geStateRowKey& key ) const;
+
+    unsigned int GetColumnCount() const override { return 3; }
+    wxString GetColumnType( unsigned int ) const override { return "string"; }
+    void GetValue( wxVariant& variant, const wxDataViewItem& item, unsigned int col ) const override;
+    bool SetValue( const wxVariant& variant, const wxDataViewItem& item, unsigned int col ) override;
+    bool GetAttr( const wxDataViewItem& item, unsigned int col, wxDataViewItemAttr& attr ) const override;
+
+    wxDataViewItem GetParent( const wxDataViewItem& item ) const override;
+    bool IsContainer( const wxDataViewItem& item ) const override;
+    bool HasContainerColumns( const wxDataViewItem& ) const override { return true; }
+    unsigned int GetChildren( const wxDataViewItem& item, wxDataViewItemArray& children ) const override;
+
+private:
+    struct Node;
+    using NodeVec = std::vector<std::unique_ptr<Node>>;
+
+    // Exactly one of mark, cat or row is set.
+    struct Node
+    {
+        Node* parent;
+        const geStateMark* mark;
+        const geStateCategory* cat;
+        const geStateRow* row;
+        NodeVec children;
+        bool populated;
+        bool changed;
+    };
+
+    static Node* ToNode( const wxDataViewItem& item ) { return static_cast<Node*>( item.GetID() ); }
+    static std::string_view NodeKey( const Node* node );
+
+    static std::unique_ptr<Node> MakeNode( Node* parent, const geStateMark& mark );
+    static std::unique_ptr<Node> MakeNode( Node* parent, const geStateCategory& cat );
+    static std::unique_ptr<Node> MakeNode( Node* parent, const geStateRow& row );
+
+    template<typename T>
+    bool Merge( Node* parent, NodeVec& children, const std::vector<T>& items );
+    bool Update( Node* node, const geStateMark& mark );
+    bool Update( Node* node, const geStateCategory& cat );
+    bool Update( Node* node, const geStateRow& row );
+
+    void Show( geStatePtr state, bool highlight );
+    void MarkChanged( Node* node );
+    void ForgetChanged( Node* node );
+    void ClearChanged();
+
+    geStatePtr m_state;       // As shown, after filtering.
+    geStatePtr m_fullState;
+    geStateIndex m_index;     // Made when first filtered.
+    std::string m_filter;
+    size_t m_rowCount;
+    bool m_highlight;
+    NodeVec m_marks;
+    std::unordered_set<Node*> m_changed;
+};
+
+// Hovering over a row whose value was cut short shows its full value in a
+// tooltip, found through the ValueFunc. The reply may come later.
+class geStateView : public wxDataViewCtrl
+{
+public:
+    using ReplyFunc = std::function<void( const std::string& value )>;
+    using ValueFunc = std::function<void( const geStateRowKey& key, ReplyFunc reply )>;
+
+    geStateView( wxWindow* parent, wxWindowID id, const wxSize& size );
+
+    void SetState( geStatePtr state );
+    void SetFilter( const wxString& text );
+    void Clear() { SetState( std::make_shared<const geState>() ); }
+    void SetValueFunc( ValueFunc func ) { m_valueFunc = std::move( func ); }
+
+private:
+    void OnMouseMove( wxMouseEvent& evt );
+    void OnMouseLeave( wxMouseEvent& evt );
+    void ResetTip();
+
+    wxObjectDataPtr<geStateModel> m_model;
+    ValueFunc m_valueFunc;
+    wxDataViewItem m_tipItem;
+    uint64_t m_tipRequest;  // Replies to earlier requests are ignored.
+};
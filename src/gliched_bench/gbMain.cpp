@@ -0,0 +1,348 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched_bench/gbMain.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Lexer and folder benchmarks over synthetic Glich scripts.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include <gltok/gltok.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+    // The number of lines styled after an edit, standing in for the visible
+    // text plus the extra page that the editor styles.
+    constexpr int EDIT_WINDOW_LINES = 120;
+
+    double seconds_since( Clock::time_point start )
+    {
+        return std::chrono::duration<double>( Clock::now() - start ).count();
+    }
+
+    // Generate a script of at least size bytes that mixes comments, strings,
+    // nested blocks, keywords and numbers.
+    std::string make_corpus( size_t size, unsigned seed )
+    {
+        static const char* keywords[] = {
+            "let", "global", "function", "object", "if", "else", "do", "while",
+            "until", "result", "write", "mark", "call", "and", "or", "not",
+            "scheme", "format", "grammar", "lexicon", "true", "false", "null"
+        };
+        static const char* names[] = {
+            "jdn", "day", "month", "year", "date", "julian", "gregorian", "count",
+            "hist", "cal", "offset", "epoch", "weekday", "leap", "era", "value"
+        };
+        std::mt19937 rng( seed );
+        auto pick = [&rng]( int n ) { return static_cast<int>( rng() % n ); };
+
+        std::string text;
+        text.reserve( size + 256 );
+        int depth = 0;
+        while( text.size() < size ) {
+            std::string indent( depth * 4, ' ' );
+            switch( pick( 10 ) ) {
+            case 0:
+                text += indent + "// " + names[pick( 16 )] + " { not a block } \"quote\n";
+                break;
+            case 1:
+                text += indent + "/* " + keywords[pick( 23 )] + " comment {\n";
+                text += indent + " * spanning \"lines\" }\n";
+                text += indent + " */\n";
+                break;
+            case 2:
+                text += indent + "write \"" + names[pick( 16 )] + " \"\"quoted\"\" {text}\" nl;\n";
+                break;
+            case 3:
+            case 4:
+                if( depth < 8 ) {
+                    text += indent + keywords[pick( 8 )] + " " + names[pick( 16 )] + " {\n";
+                    ++depth;
+                    break;
+                }
+                [[fallthrough]];
+            case 5:
+                if( depth > 0 ) {
+                    --depth;
+                    text += std::string( depth * 4, ' ' ) + "}\n";
+                    break;
+                }
+                [[fallthrough]];
+            default:
+                text += indent + keywords[pick( 23 )] + " " + names[pick( 16 )]
+                    + " = " + std::to_string( rng() % 100000 ) + " + "
+                    + names[pick( 16 )] + "[" + std::to_string( pick( 12 ) ) + "];\n";
+                break;
+            }
+        }
+        while( depth > 0 ) {
+            --depth;
+            text += std::string( depth * 4, ' ' ) + "}\n";
+        }
+        return text;
+    }
+
+    // A headless stand-in for geEditor, holding the same per-line data and
+    // styled by the same gltok::Styler.
+    class Document : public gltok::StyleDocument
+    {
+    public:
+        explicit Document( std::string text ) : m_text( std::move( text ) )
+        {
+            m_lineStart.push_back( 0 );
+            for( size_t i = 0; i < m_text.size(); ++i ) {
+                if( m_text[i] == '\n' ) {
+                    m_lineStart.push_back( i + 1 );
+                }
+            }
+            if( m_lineStart.back() == m_text.size() && m_lineStart.size() > 1 ) {
+                m_lineStart.pop_back();
+            }
+            m_styles.resize( m_text.size() );
+            m_lineState.resize( line_count() );
+            m_foldLevel.resize( line_count(), gltok::FOLD_LEVEL_BASE );
+            m_styler.text_changed( 0, line_count() );
+        }
+
+        size_t size() const { return m_text.size(); }
+
+        int line_count() const override { return static_cast<int>( m_lineStart.size() ); }
+
+        int line_from_position( size_t pos ) const override
+        {
+            auto it = std::upper_bound( m_lineStart.begin(), m_lineStart.end(), pos );
+            return static_cast<int>( it - m_lineStart.begin() ) - 1;
+        }
+
+        size_t line_start( int line ) const override
+        {
+            return (line < line_count()) ? m_lineStart[line] : m_text.size();
+        }
+
+        size_t line_length( int line ) const override
+        {
+            size_t end = (line + 1 < line_count()) ? m_lineStart[line + 1] : m_text.size();
+            return end - m_lineStart[line];
+        }
+
+        const char* text( size_t start, size_t ) override { return m_text.data() + start; }
+        int line_state( int line ) const override { return m_lineState[line]; }
+        void set_line_state( int line, int state ) override { m_lineState[line] = state; }
+        int fold_level( int line ) const override { return m_foldLevel[line]; }
+        void set_fold_level( int line, int level ) override { m_foldLevel[line] = level; }
+        size_t end_styled() const override { return m_endStyled; }
+
+        void set_styles( size_t start, const char* styles, size_t length ) override
+        {
+            std::copy( styles, styles + length, m_styles.begin() + start );
+            m_endStyled = start + length;
+        }
+
+        void set_end_styled( size_t pos ) override { m_endStyled = pos; }
+
+        // Replace one character, other than a line end, marking the document
+        // unstyled from there as Scintilla does.
+        void set_char( size_t pos, char ch )
+        {
+            m_text[pos] = ch;
+            m_endStyled = std::min( m_endStyled, pos );
+            m_styler.text_changed( line_from_position( pos ), 0 );
+        }
+
+        char get_char( size_t pos ) const { return m_text[pos]; }
+
+        // Style and fold from the first unstyled line up to endLine.
+        // Returns the number of fold levels that changed.
+        int style_to_line( int endLine ) { return m_styler.style_to_line( *this, endLine ); }
+
+    private:
+        std::string m_text;
+        std::vector<size_t> m_lineStart;
+        std::vector<char> m_styles;
+        std::vector<int> m_lineState;
+        std::vector<int> m_foldLevel;
+        size_t m_endStyled = 0;
+        gltok::Styler m_styler;
+    };
+
+    struct Percentiles
+    {
+        double p50, p90, p99, max;
+    };
+
+    // All zero if there are no samples.
+    Percentiles percentiles( std::vector<double> samples )
+    {
+        if( samples.empty() ) {
+            return { 0.0, 0.0, 0.0, 0.0 };
+        }
+        std::sort( samples.begin(), samples.end() );
+        auto at = [&samples]( double p ) {
+            size_t i = static_cast<size_t>( p * (samples.size() - 1) + 0.5 );
+            return samples[i];
+        };
+        return { at( 0.50 ), at( 0.90 ), at( 0.99 ), samples.back() };
+    }
+
+    void bench_keywords()
+    {
+        const std::unordered_set<std::string> keyword_set = {
+            "let", "global", "constant", "function", "result", "this", "command", "object",
+            "file", "write", "nl", "mark", "call", "set", "module",
+            "if", "else", "elseif",
+            "do", "in", "in:r", "while", "until", "exit",
+            "true", "false", "null", "empty", "infinity", "inf", "nan",
+            "and", "or", "not",
+            "grammar", "format", "lexicon",
+            "past", "future", "today"
+        };
+        std::string corpus = make_corpus( 4 << 20, 7 );
+        std::vector<std::string_view> words;
+        gltok::Tokenizer tokenizer( corpus );
+        gltok::Token token;
+        while( tokenizer.next( token ) ) {
+            if( token.kind == gltok::TokenKind::Keyword || token.kind == gltok::TokenKind::Identifier ) {
+                words.emplace_back( corpus.data() + token.start, token.length );
+            }
+        }
+
+        size_t found_set = 0;
+        Clock::time_point start = Clock::now();
+        for( std::string_view word : words ) {
+            found_set += keyword_set.count( std::string( word ) );
+        }
+        double set_time = seconds_since( start );
+
+        size_t found_hash = 0;
+        start = Clock::now();
+        for( std::string_view word : words ) {
+            found_hash += gltok::is_keyword( word );
+        }
+        double hash_time = seconds_since( start );
+
+        std::printf( "Keyword lookup over %zu identifiers\n", words.size() );
+        std::printf( "  std::unordered_set  %8.1f ns/lookup (%zu keywords)\n",
+            set_time * 1e9 / words.size(), found_set );
+        std::printf( "  gltok::is_keyword   %8.1f ns/lookup (%zu keywords)\n\n",
+            hash_time * 1e9 / words.size(), found_hash );
+    }
+
+    void bench_document( size_t size, int edits )
+    {
+        Document doc( make_corpus( size, static_cast<unsigned>( size ) ) );
+        double mb = doc.size() / (1024.0 * 1024.0);
+
+        // Full styling, as after loading the file.
+        Clock::time_point start = Clock::now();
+        doc.style_to_line( doc.line_count() - 1 );
+        double full = seconds_since( start );
+
+        // Single character edits at random places, as the editor styles
+        // them: from the edited line to the end of the lines shown below
+        // it, stopping early once the styles converge. Each edit is undone
+        // afterwards, and the rest of the document styled as at idle time,
+        // so that the document is the same for every edit. Line ends are
+        // never replaced, so the lines stay as they are.
+        std::mt19937 rng( 42 );
+        std::vector<double> latency;
+        latency.reserve( edits );
+        for( int i = 0; i < edits; ++i ) {
+            size_t pos = rng() % doc.size();
+            while( doc.get_char( pos ) == '\n' ) {
+                pos = (pos + 1) % doc.size();
+            }
+            int line = doc.line_from_position( pos );
+            char old = doc.get_char( pos );
+            start = Clock::now();
+            doc.set_char( pos, 'x' );
+            doc.style_to_line( line + EDIT_WINDOW_LINES );
+            latency.push_back( seconds_since( start ) * 1e6 );
+            doc.set_char( pos, old );
+            doc.style_to_line( doc.line_count() - 1 );
+        }
+        Percentiles lat = percentiles( latency );
+
+        // Fold recomputation, opening a block on the first line so that
+        // every following fold level changes.
+        doc.set_char( 0, '{' );
+        start = Clock::now();
+        int changed = doc.style_to_line( doc.line_count() - 1 );
+        double fold = seconds_since( start );
+
+        std::printf( "%10zu %9d %10.1f %10.1f %8.1f %8.1f %8.1f %8.1f %10.1f %9d\n",
+            doc.size(), doc.line_count(), full * 1e3, mb / full,
+            lat.p50, lat.p90, lat.p99, lat.max, fold * 1e3, changed );
+    }
+
+}
+
+int main( int argc, char* argv[] )
+{
+    size_t maxSize = 50u << 20;
+    int edits = 1000;
+    for( int i = 1; i < argc; ++i ) {
+        if( std::strcmp( argv[i], "--max-size" ) == 0 && i + 1 < argc ) {
+            maxSize = std::strtoul( argv[++i], nullptr, 10 ) << 10;
+        }
+        else if( std::strcmp( argv[i], "--edits" ) == 0 && i + 1 < argc ) {
+            edits = std::atoi( argv[++i] );
+            if( edits < 1 ) {
+                std::fprintf( stderr, "gliched_bench: --edits must be at least 1.\n" );
+                return 1;
+            }
+        }
+        else {
+            std::printf(
+                "Usage: gliched_bench [--max-size KB] [--edits N]\n"
+                "  --max-size KB  Largest corpus size in KB (default 51200).\n"
+                "  --edits N      Number of single character edits per corpus (default 1000).\n" );
+            return 1;
+        }
+    }
+
+    bench_keywords();
+
+    std::printf( "%10s %9s %10s %10s %8s %8s %8s %8s %10s %9s\n",
+        "", "", "Full", "Full", "Edit", "Edit", "Edit", "Edit", "Refold", "Levels" );
+    std::printf( "%10s %9s %10s %10s %8s %8s %8s %8s %10s %9s\n",
+        "Bytes", "Lines", "ms", "MB/s", "p50 us", "p90 us", "p99 us", "max us", "ms", "changed" );
+    const size_t sizes[] = { 1u << 10, 10u << 10, 100u << 10, 1u << 20, 10u << 20, 50u << 20 };
+    for( size_t size : sizes ) {
+        if( size > maxSize ) {
+            break;
+        }
+        bench_document( size, edits );
+    }
+    return 0;
+}
+
+// End of src/gliched_bench/gbMain.cpp file
@@ -0,0 +1,235 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched_run/grMain.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Run Glich scripts in parallel without the IDE.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "grProcess.h"
+#include "grReport.h"
+#include "grSession.h"
+
+#include "geScriptError.h"
+
+#include <glc/hic.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    // Scripts are run unattended, so any request for input gets an empty
+    // string, as if the user had cancelled.
+    class GrInOut : public glich::InOut
+    {
+    public:
+        std::string get_input( const std::string& ) override { return std::string(); }
+    };
+
+    // Run a single script in this process, writing its output to stdout.
+    // This is what each child process does. Returns 1 if the script stopped
+    // with a Glich error, and 2 if it could not be run.
+    int run_script_file( const std::string& filename, glich::InitLibrary lib, const glich::StdStrVec& args )
+    {
+        std::ifstream in( filename, std::ios::binary );
+        if( !in ) {
+            std::fprintf( stderr, "Unable to read %s\n", filename.c_str() );
+            return 2;
+        }
+        std::ostringstream script;
+        script << in.rdbuf();
+
+        int code = 0;
+        glich::init_hic( lib, new GrInOut, args );
+        try {
+            fs::path dir = fs::absolute( fs::path( filename ) ).parent_path();
+            glich::hic().set_file_module_paths( { dir.string() } );
+            std::string result = glich::hic().run_script( script.str(), "module" );
+            std::fwrite( result.data(), 1, result.size(), stdout );
+            if( geEndsWithError( result ) ) {
+                code = 1;
+            }
+        }
+        catch( const std::exception& e ) {
+            std::fprintf( stderr, "Error: %s\n", e.what() );
+            code = 2;
+        }
+        glich::exit_hic();
+        std::fflush( stdout );
+        return code;
+    }
+
+    // Expand directories into the .glcs files below them, in name order.
+    std::vector<std::string> find_scripts( const std::vector<std::string>& paths )
+    {
+        std::vector<std::string> files;
+        for( const std::string& path : paths ) {
+            std::error_code ec;
+            if( !fs::is_directory( path, ec ) ) {
+                files.push_back( path );
+                continue;
+            }
+            std::vector<std::string> found;
+            for( const fs::directory_entry& entry : fs::recursive_directory_iterator( path, ec ) ) {
+                if( entry.is_regular_file( ec ) && entry.path().extension() == ".glcs" ) {
+                    found.push_back( entry.path().string() );
+                }
+            }
+            std::sort( found.begin(), found.end() );
+            files.insert( files.end(), found.begin(), found.end() );
+        }
+        return files;
+    }
+
+    int usage()
+    {
+        std::printf(
+            "Usage: gliched_run [options] (file.glcs | directory)...\n"
+            "Runs each script in its own process and reports the results as JSON.\n"
+            "  -j N              Number of scripts run at once (default: number of cores).\n"
+            "  --lib none|hics   Library loaded before each script (default hics).\n"
+            "  --timeout SEC     Stop any script that runs for longer (default 0, no limit).\n"
+            "  --max-output KB   Output kept per script (default 1024).\n"
+            "  --report FILE     Write the report to FILE instead of stdout.\n"
+            "  --quiet           Don't list each result on stderr as it finishes.\n"
+            "  --session         Serve the IDE session protocol on stdin and stdout.\n" );
+        return 1;
+    }
+
+}
+
+int main( int argc, char* argv[] )
+{
+    glich::StdStrVec args( argv, argv + argc );
+    int jobs = static_cast<int>( std::thread::hardware_concurrency() );
+    std::string libname = "hics";
+    double timeout = 0.0;
+    size_t maxOutput = 1024u << 10;
+    std::string reportFile;
+    std::string childFile;
+    bool session = false;
+    bool quiet = false;
+    std::vector<std::string> paths;
+    for( int i = 1; i < argc; ++i ) {
+        if( std::strcmp( argv[i], "-j" ) == 0 && i + 1 < argc ) {
+            jobs = std::atoi( argv[++i] );
+        }
+        else if( std::strcmp( argv[i], "--lib" ) == 0 && i + 1 < argc ) {
+            libname = argv[++i];
+        }
+        else if( std::strcmp( argv[i], "--timeout" ) == 0 && i + 1 < argc ) {
+            timeout = std::atof( argv[++i] );
+        }
+        else if( std::strcmp( argv[i], "--max-output" ) == 0 && i + 1 < argc ) {
+            maxOutput = std::strtoul( argv[++i], nullptr, 10 ) << 10;
+        }
+        else if( std::strcmp( argv[i], "--report" ) == 0 && i + 1 < argc ) {
+            reportFile = argv[++i];
+        }
+        else if( std::strcmp( argv[i], "--child" ) == 0 && i + 1 < argc ) {
+            childFile = argv[++i];
+        }
+        else if( std::strcmp( argv[i], "--session" ) == 0 ) {
+            session = true;
+        }
+        else if( std::strcmp( argv[i], "--quiet" ) == 0 ) {
+            quiet = true;
+        }
+        else if( argv[i][0] == '-' ) {
+            return usage();
+        }
+        else {
+            paths.push_back( argv[i] );
+        }
+    }
+    if( libname != "none" && libname != "hics" ) {
+        return usage();
+    }
+    glich::InitLibrary lib = libname == "none" ? glich::InitLibrary::None : glich::InitLibrary::Hics;
+    if( session ) {
+        return gr::run_session( lib, args );
+    }
+    if( !childFile.empty() ) {
+        return run_script_file( childFile, lib, args );
+    }
+    if( paths.empty() ) {
+        return usage();
+    }
+
+    gr::Report report;
+    for( const std::string& file : find_scripts( paths ) ) {
+        report.scripts.push_back( { file, gr::ChildResult() } );
+    }
+    report.jobs = std::max( 1, std::min( jobs, static_cast<int>( report.scripts.size() ) ) );
+
+    // Each worker takes the next script not yet started, so long scripts
+    // don't hold up the rest.
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> next( 0 );
+    std::vector<std::thread> workers;
+    for( int i = 0; i < report.jobs; ++i ) {
+        workers.emplace_back( [&]() {
+            for( size_t n = next++; n < report.scripts.size(); n = next++ ) {
+                gr::ScriptResult& script = report.scripts[n];
+                script.run = gr::run_child( argv[0], { "--lib", libname, "--child", script.file }, timeout, maxOutput );
+                if( !quiet ) {
+                    std::fprintf( stderr, "[%s] %s (%.1f ms)\n", script.status(), script.file.c_str(), script.run.wall * 1e3 );
+                }
+            }
+        } );
+    }
+    for( std::thread& worker : workers ) {
+        worker.join();
+    }
+    report.wall = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+    std::string json = gr::to_json( report );
+    if( reportFile.empty() ) {
+        std::fwrite( json.data(), 1, json.size(), stdout );
+    }
+    else {
+        std::ofstream out( reportFile, std::ios::binary );
+        out << json;
+        if( !out ) {
+            std::fprintf( stderr, "Unable to write %s\n", reportFile.c_str() );
+            return 2;
+        }
+    }
+    bool allPassed = std::all_of( report.scripts.begin(), report.scripts.end(),
+        []( const gr::ScriptResult& script ) { return script.passed(); } );
+    return allPassed ? 0 : 1;
+}
+
+// End of src/gliched_run/grMain.cpp file
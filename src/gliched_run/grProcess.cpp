@@ -0,0 +1,280 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched_run/grProcess.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Run a child process and collect its output.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "grProcess.h"
+
+#include <cerrno>
+#include <chrono>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+using namespace gr;
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+    // Pipes are created and handed to a child under this lock, and the
+    // parent's copy of the write end is closed before it is released, so
+    // that no other child can inherit it and hold the pipe open.
+    std::mutex s_spawn_mutex;
+
+    void append_output( ChildResult& result, const char* data, size_t size, size_t max_output )
+    {
+        size_t room = max_output - result.output.size();
+        if( size > room ) {
+            // Don't split a UTF-8 sequence.
+            while( room > 0 && ( static_cast<unsigned char>( data[room] ) & 0xC0 ) == 0x80 ) {
+                --room;
+            }
+            result.output.append( data, room );
+            result.truncated = true;
+            return;
+        }
+        result.output.append( data, size );
+    }
+
+    double seconds_since( Clock::time_point start )
+    {
+        return std::chrono::duration<double>( Clock::now() - start ).count();
+    }
+
+}
+
+#ifdef _WIN32
+
+namespace {
+
+    // Quote an argument so that it is parsed back by CommandLineToArgvW
+    // and the C runtime unchanged.
+    std::string quote_arg( const std::string& arg )
+    {
+        if( !arg.empty() && arg.find_first_of( " \t\"" ) == std::string::npos ) {
+            return arg;
+        }
+        std::string out = "\"";
+        size_t slashes = 0;
+        for( char ch : arg ) {
+            if( ch == '\\' ) {
+                ++slashes;
+                continue;
+            }
+            out.append( ch == '"' ? slashes * 2 + 1 : slashes, '\\' );
+            slashes = 0;
+            out += ch;
+        }
+        out.append( slashes * 2, '\\' );
+        return out + "\"";
+    }
+
+    double filetime_seconds( const FILETIME& ft )
+    {
+        ULARGE_INTEGER value;
+        value.LowPart = ft.dwLowDateTime;
+        value.HighPart = ft.dwHighDateTime;
+        return value.QuadPart * 1e-7;
+    }
+
+}
+
+ChildResult gr::run_child(
+    const std::string& program, const std::vector<std::string>& args,
+    double timeout, size_t max_output )
+{
+    ChildResult result;
+    std::string cmdline = quote_arg( program );
+    for( const std::string& arg : args ) {
+        cmdline += " " + quote_arg( arg );
+    }
+
+    Clock::time_point start = Clock::now();
+    HANDLE read_pipe = nullptr;
+    PROCESS_INFORMATION pi = {};
+    {
+        std::lock_guard<std::mutex> lock( s_spawn_mutex );
+        SECURITY_ATTRIBUTES sa = { sizeof( sa ), nullptr, TRUE };
+        HANDLE write_pipe = nullptr;
+        if( !CreatePipe( &read_pipe, &write_pipe, &sa, 0 ) ) {
+            return result;
+        }
+        SetHandleInformation( read_pipe, HANDLE_FLAG_INHERIT, 0 );
+        HANDLE null_input = CreateFileA( "NUL", GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+            &sa, OPEN_EXISTING, 0, nullptr );
+
+        STARTUPINFOA si = {};
+        si.cb = sizeof( si );
+        si.dwFlags = STARTF_USESTDHANDLES;
+        si.hStdInput = null_input;
+        si.hStdOutput = write_pipe;
+        si.hStdError = write_pipe;
+        result.started = CreateProcessA( nullptr, &cmdline[0], nullptr, nullptr, TRUE,
+            CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi ) != 0;
+        CloseHandle( write_pipe );
+        if( null_input != INVALID_HANDLE_VALUE ) {
+            CloseHandle( null_input );
+        }
+    }
+    if( !result.started ) {
+        CloseHandle( read_pipe );
+        return result;
+    }
+
+    char buf[65536];
+    for( ;; ) {
+        DWORD avail = 0;
+        if( !PeekNamedPipe( read_pipe, nullptr, 0, nullptr, &avail, nullptr ) ) {
+            break; // The child has closed its end.
+        }
+        if( avail > 0 ) {
+            DWORD got = 0;
+            if( !ReadFile( read_pipe, buf, sizeof( buf ), &got, nullptr ) || got == 0 ) {
+                break;
+            }
+            append_output( result, buf, got, max_output );
+            continue;
+        }
+        if( timeout > 0.0 && seconds_since( start ) > timeout ) {
+            TerminateProcess( pi.hProcess, 1 );
+            result.timed_out = true;
+            break;
+        }
+        WaitForSingleObject( pi.hProcess, 10 );
+    }
+    WaitForSingleObject( pi.hProcess, INFINITE );
+    result.wall = seconds_since( start );
+
+    DWORD code = 0;
+    if( !result.timed_out && GetExitCodeProcess( pi.hProcess, &code ) ) {
+        result.exit_code = static_cast<int>( code );
+    }
+    FILETIME created, exited, kernel, user;
+    if( GetProcessTimes( pi.hProcess, &created, &exited, &kernel, &user ) ) {
+        result.cpu = filetime_seconds( kernel ) + filetime_seconds( user );
+    }
+    CloseHandle( pi.hThread );
+    CloseHandle( pi.hProcess );
+    CloseHandle( read_pipe );
+    return result;
+}
+
+#else
+
+ChildResult gr::run_child(
+    const std::string& program, const std::vector<std::string>& args,
+    double timeout, size_t max_output )
+{
+    ChildResult result;
+    std::vector<char*> argv;
+    argv.push_back( const_cast<char*>( program.c_str() ) );
+    for( const std::string& arg : args ) {
+        argv.push_back( const_cast<char*>( arg.c_str() ) );
+    }
+    argv.push_back( nullptr );
+
+    Clock::time_point start = Clock::now();
+    int fds[2];
+    pid_t pid = 0;
+    {
+        std::lock_guard<std::mutex> lock( s_spawn_mutex );
+        if( pipe( fds ) != 0 ) {
+            return result;
+        }
+        fcntl( fds[0], F_SETFD, FD_CLOEXEC );
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init( &actions );
+        posix_spawn_file_actions_addopen( &actions, 0, "/dev/null", O_RDONLY, 0 );
+        posix_spawn_file_actions_adddup2( &actions, fds[1], 1 );
+        posix_spawn_file_actions_adddup2( &actions, fds[1], 2 );
+        posix_spawn_file_actions_addclose( &actions, fds[1] );
+        result.started = posix_spawnp( &pid, program.c_str(), &actions, nullptr, argv.data(), environ ) == 0;
+        posix_spawn_file_actions_destroy( &actions );
+        close( fds[1] );
+    }
+    if( !result.started ) {
+        close( fds[0] );
+        return result;
+    }
+
+    char buf[65536];
+    for( ;; ) {
+        int wait_ms = -1;
+        if( timeout > 0.0 ) {
+            double left = timeout - seconds_since( start );
+            if( left <= 0.0 ) {
+                kill( pid, SIGKILL );
+                result.timed_out = true;
+                break;
+            }
+            wait_ms = static_cast<int>( left * 1e3 ) + 1;
+        }
+        pollfd pfd = { fds[0], POLLIN, 0 };
+        int ready = poll( &pfd, 1, wait_ms );
+        if( ready < 0 && errno != EINTR ) {
+            break;
+        }
+        if( ready <= 0 ) {
+            continue;
+        }
+        ssize_t got = read( fds[0], buf, sizeof( buf ) );
+        if( got < 0 && errno == EINTR ) {
+            continue;
+        }
+        if( got <= 0 ) {
+            break; // End of output.
+        }
+        append_output( result, buf, static_cast<size_t>( got ), max_output );
+    }
+    close( fds[0] );
+
+    int status = 0;
+    rusage usage = {};
+    while( wait4( pid, &status, 0, &usage ) < 0 && errno == EINTR ) {
+    }
+    result.wall = seconds_since( start );
+    if( !result.timed_out && WIFEXITED( status ) ) {
+        result.exit_code = WEXITSTATUS( status );
+    }
+    result.cpu = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6
+        + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+    return result;
+}
+
+#endif
+
+// End of src/gliched_run/grProcess.cpp file
@@ -0,0 +1,55 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched_run/grProcess.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Run a child process and collect its output header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace gr {
+
+    struct ChildResult
+    {
+        int exit_code = -1;     // -1 if the process did not exit normally.
+        bool started = false;
+        bool timed_out = false;
+        bool truncated = false; // Output beyond the limit was discarded.
+        double wall = 0.0;      // Seconds.
+        double cpu = 0.0;       // User plus system seconds, where known.
+        std::string output;     // Combined stdout and stderr.
+    };
+
+    // Run program with args, with stdin empty and both stdout and stderr
+    // captured. The process is killed if it runs for more than timeout
+    // seconds, unless timeout is 0. At most max_output bytes are kept.
+    // Safe to call from several threads at once.
+    ChildResult run_child(
+        const std::string& program, const std::vector<std::string>& args,
+        double timeout, size_t max_output );
+
+}
+
+// End of src/gliched_run/grProcess.h file
@@ -0,0 +1,92 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched_run/grReport.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Batch run report.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "grReport.h"
+
+#include <cstdio>
+
+using namespace gr;
+
+const char* ScriptResult::status() const
+{
+    if( !run.started ) {
+        return "not started";
+    }
+    if( run.timed_out ) {
+        return "timeout";
+    }
+    return run.exit_code == 0 ? "ok" : "failed";
+}
+
+std::string gr::json_quote( const std::string& str )
+{
+    std::string out = "\"";
+    for( unsigned char ch : str ) {
+        switch( ch ) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if( ch < 0x20 ) {
+                char buf[8];
+                std::snprintf( buf, sizeof( buf ), "\\u%04x", ch );
+                out += buf;
+            }
+            else {
+                out += static_cast<char>( ch );
+            }
+        }
+    }
+    return out + "\"";
+}
+
+std::string gr::to_json( const Report& report )
+{
+    size_t passed = 0;
+    for( const ScriptResult& script : report.scripts ) {
+        passed += script.passed() ? 1 : 0;
+    }
+    char buf[256];
+    std::snprintf( buf, sizeof( buf ),
+        "{\n  \"jobs\": %d,\n  \"wall\": %.6f,\n  \"total\": %zu,\n  \"passed\": %zu,\n  \"failed\": %zu,\n  \"scripts\": [",
+        report.jobs, report.wall, report.scripts.size(), passed, report.scripts.size() - passed );
+    std::string out = buf;
+    const char* sep = "\n";
+    for( const ScriptResult& script : report.scripts ) {
+        std::snprintf( buf, sizeof( buf ),
+            "\"status\": \"%s\", \"exit\": %d, \"wall\": %.6f, \"cpu\": %.6f, \"truncated\": %s,\n      \"output\": ",
+            script.status(), script.run.exit_code, script.run.wall, script.run.cpu,
+            script.run.truncated ? "true" : "false" );
+        out += sep;
+        out += "    { \"file\": " + json_quote( script.file ) + ", " + buf + json_quote( script.run.output ) + " }";
+        sep = ",\n";
+    }
+    return out + "\n  ]\n}\n";
+}
+
+// End of src/gliched_run/grReport.cpp file
@@ -0,0 +1,57 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched_run/grReport.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Batch run report header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include "grProcess.h"
+
+#include <string>
+#include <vector>
+
+namespace gr {
+
+    struct ScriptResult
+    {
+        std::string file;
+        ChildResult run;
+
+        bool passed() const { return run.started && !run.timed_out && run.exit_code == 0; }
+        const char* status() const;
+    };
+
+    struct Report
+    {
+        int jobs = 0;
+        double wall = 0.0;
+        std::vector<ScriptResult> scripts;
+    };
+
+    std::string json_quote( const std::string& str );
+    std::string to_json( const Report& report );
+
+}
+
+// End of src/gliched_run/grReport.h file
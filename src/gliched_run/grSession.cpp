@@ -0,0 +1,163 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched_run/grSession.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Long running interpreter session.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include "grSession.h"
+
+#include "geProfile.h"
+#include "geRunStats.h"
+#include "geState.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+using namespace gr;
+
+namespace {
+
+    // Input requests are passed back to the IDE.
+    class SessionInOut : public glich::InOut
+    {
+    public:
+        std::string get_input( const std::string& prompt ) override
+        {
+            std::string name, answer;
+            if( !write_message( stdout, "INPUT", prompt )
+                || !read_message( stdin, name, answer ) || name != "ANSWER" )
+            {
+                return std::string();
+            }
+            return answer;
+        }
+    };
+
+    std::vector<std::string> split_lines( const std::string& text )
+    {
+        std::vector<std::string> lines;
+        size_t pos = 0;
+        while( pos < text.size() ) {
+            size_t end = text.find( '\n', pos );
+            if( end == std::string::npos ) {
+                end = text.size();
+            }
+            lines.push_back( text.substr( pos, end - pos ) );
+            pos = end + 1;
+        }
+        return lines;
+    }
+
+}
+
+bool gr::read_message( std::FILE* in, std::string& name, std::string& payload )
+{
+    char header[128];
+    if( !std::fgets( header, sizeof( header ), in ) ) {
+        return false;
+    }
+    char* space = std::strchr( header, ' ' );
+    if( !space ) {
+        return false;
+    }
+    name.assign( header, space - header );
+    size_t size = std::strtoull( space + 1, nullptr, 10 );
+    payload.resize( size );
+    return size == 0 || std::fread( &payload[0], 1, size, in ) == size;
+}
+
+bool gr::write_message( std::FILE* out, const std::string& name, const std::string& payload )
+{
+    std::fprintf( out, "%s %zu\n", name.c_str(), payload.size() );
+    std::fwrite( payload.data(), 1, payload.size(), out );
+    return std::fflush( out ) == 0;
+}
+
+int gr::run_session( glich::InitLibrary lib, const glich::StdStrVec& args )
+{
+#ifdef _WIN32
+    _setmode( _fileno( stdin ), _O_BINARY );
+    _setmode( _fileno( stdout ), _O_BINARY );
+#endif
+    glich::init_hic( lib, new SessionInOut, args );
+    write_message( stdout, "READY", glich::hic().version() );
+    write_message( stdout, "STATE", geState::Capture().Serialize() );
+
+    std::string name, payload;
+    while( read_message( stdin, name, payload ) ) {
+        if( name == "PATHS" ) {
+            glich::hic().set_file_module_paths( split_lines( payload ) );
+        }
+        else if( name == "RUN" || name == "PROFILE" ) {
+            geRunTimer timer;
+            std::string result;
+            geProfile profile;
+            if( name == "PROFILE" ) {
+                // Cancelling ends the process, so the run is never cancelled
+                // from here.
+                geRunStats counts;
+                std::atomic<bool> cancelled( false );
+                geProfileScript( payload, "module", [&result]( std::string&& text ) { result += text; },
+                    counts, profile, cancelled );
+            }
+            else {
+                try {
+                    result = glich::hic().run_script( payload, "module" );
+                }
+                catch( const std::exception& e ) {
+                    result = std::string( "Error: " ) + e.what() + "\n";
+                }
+            }
+            geRunStats stats = timer.Stop();
+            char figures[128];
+            std::snprintf( figures, sizeof( figures ), "%.6f %.6f %.6f %zu",
+                stats.wall, stats.user, stats.system, stats.peakRssDelta );
+            write_message( stdout, "OUTPUT", result );
+            if( name == "PROFILE" ) {
+                write_message( stdout, "PROFILE", geSerializeProfile( profile ) );
+            }
+            write_message( stdout, "DONE", figures );
+            write_message( stdout, "STATE", geState::Capture().Serialize() );
+        }
+        else if( name == "VALUE" ) {
+            geStateRowKey key;
+            std::string value;
+            if( !geState::ParseKey( payload, key ) || !geState::FindValue( key, value ) ) {
+                value.clear();
+            }
+            write_message( stdout, "VALUE", value );
+        }
+    }
+    glich::exit_hic();
+    return 0;
+}
+
+// End of src/gliched_run/grSession.cpp file
@@ -0,0 +1,64 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gliched_run/grSession.h
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Long running interpreter session header.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#pragma once
+
+#include <glc/hic.h>
+
+#include <cstdio>
+#include <string>
+
+namespace gr {
+
+    // The session protocol, used by the IDE to keep a separate interpreter
+    // in its own process for each tab. Every message, in either direction,
+    // is a line "NAME size" followed by size bytes of payload.
+    //
+    // To the session:
+    //   PATHS   Module search paths, one per line.
+    //   RUN     Script text to run.
+    //   PROFILE Script text to run one statement at a time, timing each.
+    //   ANSWER  Reply to an INPUT request.
+    //   VALUE   Between runs, a row key as geState::SerializeKey.
+    // From the session:
+    //   READY   Sent once at start, with the interpreter version, followed
+    //           by the STATE after loading the library.
+    //   INPUT   The script is asking for input, with the prompt.
+    //   OUTPUT  The output of a run.
+    //   PROFILE After the OUTPUT of a profiled run, as geSerializeProfile.
+    //   DONE    Run figures: "wall user system peak-rss-delta".
+    //   STATE   The interpreter state after the run, as geState::Serialize.
+    //   VALUE   The full value of the row asked for, or empty if not found.
+    // The session ends when its input is closed.
+
+    bool read_message( std::FILE* in, std::string& name, std::string& payload );
+    bool write_message( std::FILE* out, const std::string& name, const std::string& payload );
+
+    int run_session( glich::InitLibrary lib, const glich::StdStrVec& args );
+
+}
+
+// End of src/gliched_run/grSession.h file
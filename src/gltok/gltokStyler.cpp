@@ -0,0 +1,120 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gltok/gltokStyler.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Incremental styling and folding of Glich script documents.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+
+ */
+
+#include <gltok/gltok.h>
+
+#include <algorithm>
+
+using namespace gltok;
+
+void Styler::text_changed( int line, int linesAdded )
+{
+    if( m_styledLines > line ) {
+        m_styledLines = std::max( line, m_styledLines + linesAdded );
+    }
+    if( m_changedLine > line ) {
+        m_changedLine = std::max( line, m_changedLine + linesAdded );
+    }
+    m_changedLine = std::max( m_changedLine, line + std::max( linesAdded, 0 ) );
+}
+
+int Styler::style_to_line( StyleDocument& doc, int endLine )
+{
+    // Everything before the first unstyled line is unchanged since the last
+    // call, so restart there with the lexer state and fold level saved at
+    // the end of the line before it. Lines after the styled range keep their
+    // old styles and levels until they are styled, so a single pass over the
+    // range both colours and folds it.
+    int startLine = doc.line_from_position( doc.end_styled() );
+    endLine = std::min( endLine, doc.line_count() - 1 );
+    if( endLine < startLine ) {
+        return 0;
+    }
+    LexState state = LexState::Default;
+    int level = FOLD_LEVEL_BASE;
+    if( startLine > 0 ) {
+        int lineState = doc.line_state( startLine - 1 );
+        state = line_lex_state( lineState );
+        level = lineState >> LINESTATE_LEVELSHIFT;
+    }
+
+    size_t startPos = doc.line_start( startLine );
+    size_t endPos = doc.line_start( endLine ) + doc.line_length( endLine );
+    const char* text = doc.text( startPos, endPos - startPos );
+    m_styles.resize( endPos - startPos );
+
+    char* lineStyles = m_styles.data();
+    int changed = 0;
+    int line = startLine;
+    bool converged = false;
+    for( ; line <= endLine && !converged; ++line ) {
+        size_t lineLength = doc.line_length( line );
+        LineInfo info = style_line( std::string_view( text, lineLength ), state, lineStyles );
+        state = info.state;
+
+        // Folding logic for { ... } blocks
+        int flags = level;
+        if( info.opens > 0 ) {
+            flags |= FOLD_LEVEL_HEADER_FLAG;
+        }
+        if( doc.fold_level( line ) != flags ) {
+            doc.set_fold_level( line, flags );
+            ++changed;
+        }
+
+        // The next line's level is increased if a block is opened
+        level += info.opens - info.closes;
+        if( level < FOLD_LEVEL_BASE ) {
+            level = FOLD_LEVEL_BASE;
+        }
+
+        // Past the edited lines, once a line ends with the same lexer state
+        // and next fold level as it was saved with, every following line that
+        // was styled before is unchanged as well.
+        int lineState = static_cast<int>( state ) | (level << LINESTATE_LEVELSHIFT);
+        converged = line > m_changedLine && line + 1 < m_styledLines && doc.line_state( line ) == lineState;
+        doc.set_line_state( line, lineState );
+        text += lineLength;
+        lineStyles += lineLength;
+    }
+    doc.set_styles( startPos, m_styles.data(), lineStyles - m_styles.data() );
+
+    // line is now one past the last line styled.
+    if( line > m_changedLine ) {
+        m_changedLine = -1;
+    }
+    if( converged ) {
+        // Skip over the lines that still hold valid styles.
+        doc.set_end_styled( doc.line_start( m_styledLines ) );
+    }
+    else if( line > m_styledLines ) {
+        m_styledLines = line;
+    }
+    return changed;
+}
+
+// End of src/gltok/gltokStyler.cpp file
@@ -0,0 +1,302 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        src/gltok/gltokTokenizer.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Glich script tokenizer source.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+ */
+
+#include <gltok/gltok.h>
+
+#include <algorithm>
+
+using namespace gltok;
+
+namespace {
+
+    constexpr std::string_view glich_keywords[] = {
+        "let", "global", "constant", "function", "result", "this", "command", "object",
+        "file", "write", "nl", "mark", "call", "set", "module",
+        "if", "else", "elseif",
+        "do", "in", "in:r", "while", "until", "exit",
+        "true", "false", "null", "empty", "infinity", "inf", "nan",
+        "and", "or", "not",
+        "grammar", "format", "lexicon",
+        "past", "future", "today"
+    };
+
+    // Keywords are found with a perfect hash of the word length and its first,
+    // second and last characters. The table is built at compile time and the
+    // static_assert below fails if a new keyword collides with an existing one,
+    // in which case the multipliers in keyword_hash need to be changed.
+    constexpr size_t keyword_table_size = 128;
+
+    constexpr size_t keyword_hash( std::string_view word )
+    {
+        size_t c0 = static_cast<unsigned char>( word[0] );
+        size_t c1 = static_cast<unsigned char>( word[1] );
+        size_t cn = static_cast<unsigned char>( word[word.size() - 1] );
+        return (word.size() + c0 * 11 + c1 + cn * 10) & (keyword_table_size - 1);
+    }
+
+    struct KeywordTable
+    {
+        std::string_view slot[keyword_table_size] = {};
+        size_t min_length = std::string_view::npos;
+        size_t max_length = 0;
+        bool perfect = true;
+    };
+
+    constexpr KeywordTable make_keyword_table()
+    {
+        KeywordTable table;
+        for( std::string_view word : glich_keywords ) {
+            size_t h = keyword_hash( word );
+            if( !table.slot[h].empty() ) {
+                table.perfect = false;
+            }
+            table.slot[h] = word;
+            table.min_length = std::min( table.min_length, word.size() );
+            table.max_length = std::max( table.max_length, word.size() );
+        }
+        return table;
+    }
+
+    constexpr KeywordTable keyword_table = make_keyword_table();
+    static_assert( keyword_table.perfect, "Glich keyword hash has a collision." );
+    static_assert( keyword_table.min_length >= 2, "keyword_hash requires at least 2 characters." );
+
+}
+
+bool gltok::is_keyword( std::string_view word )
+{
+    if( word.size() < keyword_table.min_length || word.size() > keyword_table.max_length ) {
+        return false;
+    }
+    return keyword_table.slot[keyword_hash( word )] == word;
+}
+
+bool Tokenizer::next( Token& token )
+{
+    const char* text = m_text.data();
+    const size_t end = m_text.size();
+    size_t pos = m_pos;
+    if( pos >= end ) {
+        return false;
+    }
+    token.start = pos;
+
+    if( m_state == LexState::Comment ) {
+        token.kind = TokenKind::Comment;
+        pos = scan_comment( pos );
+    }
+    else if( m_state == LexState::String ) {
+        token.kind = TokenKind::String;
+        pos = scan_string( pos );
+    }
+    else {
+        char c = text[pos];
+        char next = (pos + 1 < end) ? text[pos + 1] : '\0';
+        unsigned char cc = char_class_at( text + pos );
+
+        if( c == '/' && next == '*' ) {
+            // Multi-line comment
+            token.kind = TokenKind::Comment;
+            m_state = LexState::Comment;
+            pos = scan_comment( pos + 2 );
+        }
+        else if( c == '/' && next == '/' ) {
+            // Single-line comment, up to the end of line characters
+            token.kind = TokenKind::Comment;
+            while( pos < end && !(char_class_at( text + pos ) & CC_EOL) ) ++pos;
+        }
+        else if( cc & CC_QUOTE ) {
+            token.kind = TokenKind::String;
+            m_state = LexState::String;
+            pos = scan_string( pos + 1 );
+        }
+        else if( cc & CC_DIGIT ) {
+            token.kind = TokenKind::Number;
+            while( pos < end && (char_class_at( text + pos ) & CC_DIGIT) ) ++pos;
+        }
+        else if( cc & CC_IDSTART ) {
+            // Identifier (allowing : and _)
+            while( pos < end && (char_class_at( text + pos ) & CC_IDCHAR) ) ++pos;
+            std::string_view word( text + token.start, pos - token.start );
+            token.kind = is_keyword( word ) ? TokenKind::Keyword : TokenKind::Identifier;
+        }
+        else if( cc & CC_OPERATOR ) {
+            token.kind = TokenKind::Operator;
+            ++pos;
+        }
+        else {
+            // Whitespace or anything else, taken as one run
+            token.kind = TokenKind::Default;
+            while( pos < end && !(char_class_at( text + pos ) & CC_TOKENSTART) ) ++pos;
+        }
+    }
+    token.length = pos - token.start;
+    m_pos = pos;
+    return true;
+}
+
+// Scan to just after the closing "*/", or to the end of the text.
+size_t Tokenizer::scan_comment( size_t pos )
+{
+    const char* text = m_text.data();
+    const size_t end = m_text.size();
+    while( pos < end ) {
+        if( text[pos] == '*' && pos + 1 < end && text[pos + 1] == '/' ) {
+            m_state = LexState::Default;
+            return pos + 2;
+        }
+        ++pos;
+    }
+    return end;
+}
+
+// Scan to just after the closing quote, or to the end of the text.
+// A doubled quote is an escaped quote.
+size_t Tokenizer::scan_string( size_t pos )
+{
+    const char* text = m_text.data();
+    const size_t end = m_text.size();
+    while( pos < end ) {
+        if( text[pos] == '"' ) {
+            if( pos + 1 < end && text[pos + 1] == '"' ) {
+                pos += 2;
+                continue;
+            }
+            m_state = LexState::Default;
+            return pos + 1;
+        }
+        ++pos;
+    }
+    return end;
+}
+
+LineInfo gltok::style_line( std::string_view line, LexState state, char* styles )
+{
+    LineInfo info = { state, 0, 0 };
+    Tokenizer tokenizer( line, state );
+    Token token;
+    while( tokenizer.next( token ) ) {
+        if( token.kind == TokenKind::Operator ) {
+            if( line[token.start] == '{' ) ++info.opens;
+            if( line[token.start] == '}' ) ++info.closes;
+            styles[token.start] = static_cast<char>( TokenKind::Operator );
+            continue;
+        }
+        std::fill_n( styles + token.start, token.length, static_cast<char>( token.kind ) );
+    }
+    info.state = tokenizer.state();
+    return info;
+}
+
+bool gltok::line_opens_block( std::string_view line, LexState state )
+{
+    bool opens = false;
+    Tokenizer tokenizer( line, state );
+    Token token;
+    while( tokenizer.next( token ) ) {
+        if( token.kind == TokenKind::Default || token.kind == TokenKind::Comment ) {
+            continue;
+        }
+        opens = (token.kind == TokenKind::Operator && line[token.start] == '{');
+    }
+    return opens;
+}
+
+// True if a statement that starts with this token can end with the '}' of
+// its block, as in "function f { ... }" or "if( x ) { ... } else { ... }".
+static bool starts_block_statement( const Token& token, std::string_view text )
+{
+    if( token.kind == TokenKind::Operator ) {
+        return text == "{";
+    }
+    return token.kind == TokenKind::Keyword && (
+        text == "function" || text == "command" || text == "object" ||
+        text == "if" || text == "do" ||
+        text == "grammar" || text == "format" || text == "lexicon" );
+}
+
+std::vector<Range> gltok::top_level_statements( std::string_view script )
+{
+    std::vector<Range> statements;
+    size_t start = std::string_view::npos; // Start of the current statement.
+    size_t end = 0;                       // End of the last significant token.
+    bool blockStatement = false;
+    bool blockClosed = false;
+    int depth = 0;
+
+    auto close = [&]() {
+        statements.push_back( { start, end - start } );
+        start = std::string_view::npos;
+        blockClosed = false;
+    };
+
+    Tokenizer tokenizer( script );
+    Token token;
+    while( tokenizer.next( token ) ) {
+        if( token.kind == TokenKind::Default || token.kind == TokenKind::Comment ) {
+            continue;
+        }
+        std::string_view text = script.substr( token.start, token.length );
+        if( blockClosed ) {
+            if( token.kind == TokenKind::Keyword && (text == "else" || text == "elseif") ) {
+                blockClosed = false;
+            }
+            else if( token.kind == TokenKind::Operator && text == ";" ) {
+                end = token.start + token.length;
+                close();
+                continue;
+            }
+            else {
+                close();
+            }
+        }
+        if( start == std::string_view::npos ) {
+            start = token.start;
+            blockStatement = starts_block_statement( token, text );
+        }
+        end = token.start + token.length;
+        if( token.kind != TokenKind::Operator ) {
+            continue;
+        }
+        char c = text[0];
+        if( c == '{' || c == '(' || c == '[' ) {
+            ++depth;
+        }
+        else if( c == '}' || c == ')' || c == ']' ) {
+            depth = (depth > 0) ? depth - 1 : 0;
+            blockClosed = (blockStatement && depth == 0 && c == '}');
+        }
+        else if( c == ';' && depth == 0 ) {
+            close();
+        }
+    }
+    if( start != std::string_view::npos ) {
+        close();
+    }
+    return statements;
+}
+
+// End of src/gltok/gltokTokenizer.cpp file
@@ -0,0 +1,146 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Name:        test/gliched/gtMain.cpp
+ * Project:     Gliched: Glich Script Language IDE.
+ * Purpose:     Unit tests for the IDE classes that do not need a window.
+ * Author:      Nick Matthews
+ * Created:     17th October 2026
+ * Copyright:   Copyright (c) 2026, Nick Matthews.
+ * Licence:     GNU GPLv3
+ *
+ *  Gliched is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Gliched is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Gliched.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+
+
+ */
+
+#include "geRunCache.h"
+#include "geSessionPool.h"
+
+#include <wx/init.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+    int s_failures = 0;
+
+    void check( bool ok, const char* what )
+    {
+        if( !ok ) {
+            std::fprintf( stderr, "FAILED: %s\n", what );
+            ++s_failures;
+        }
+    }
+
+    // The pool must report every session it destroys, so that the frame can
+    // clear its pointer to the session shown in the output and state panes.
+    void test_session_pool( const wxString& command )
+    {
+        geSession* shown = nullptr;
+        geSessionPool pool( 1, nullptr, nullptr,
+            [&shown]( geSession* session ) { if( session == shown ) shown = nullptr; } );
+        pool.SetCommand( command );
+        int tab1 = 0, tab2 = 0;
+
+        // Get for a new tab closes the least recently used idle session.
+        shown = pool.Get( &tab1 );
+        check( shown != nullptr, "Get creates a session" );
+        geSession* session2 = pool.Get( &tab2 );
+        check( session2 != nullptr, "Get makes room in a full pool" );
+        check( shown == nullptr, "Get reports the session it evicts" );
+        check( pool.Find( &tab1 ) == nullptr, "The evicted session is gone" );
+
+        // Reset of a tab without a session evicts through Get.
+        shown = session2;
+        geSession* session1 = pool.Reset( &tab1 );
+        check( session1 != nullptr, "Reset creates a session" );
+        check( shown == nullptr, "Reset reports the session Get evicts" );
+
+        // Reset replaces the tab's own session.
+        shown = session1;
+        pool.Reset( &tab1 );
+        check( shown == nullptr, "Reset reports the session it replaces" );
+
+        shown = pool.Find( &tab1 );
+        pool.Release( &tab1 );
+        check( shown == nullptr, "Release reports the session it closes" );
+    }
+
+
+    void write_file( const std::filesystem::path& path, const std::string& text )
+    {
+        std::ofstream out( path, std::ios::binary | std::ios::trunc );
+        out << text;
+    }
+
+    // Module files whose names differ only in case are different files on
+    // Linux, so each must change the key. A cache entry is only found by
+    // the key it was stored with, even if another key has the same id.
+    void test_run_cache( const std::string& dir )
+    {
+        namespace fs = std::filesystem;
+        fs::path modules = fs::path( dir ) / "modules";
+        fs::remove_all( dir );
+        fs::create_directories( modules );
+        write_file( modules / "Lib.glcs", "let a = 1;\n" );
+        write_file( modules / "lib.glcs", "let a = 2;\n" );
+        std::vector<std::string> paths = { modules.string() };
+        std::string script = "call lib:f;\n";
+
+        geRunKey key = geRunCache::MakeKey( script, paths, "1", 0 );
+        check( key.id != 0, "MakeKey gives a key" );
+        write_file( modules / "Lib.glcs", "let a = 3;\n" );
+        geRunKey upper = geRunCache::MakeKey( script, paths, "1", 0 );
+        check( upper.id != key.id, "Each case variant of a module is in the key" );
+        write_file( modules / "lib.glcs", "let a = 4;\n" );
+        geRunKey lower = geRunCache::MakeKey( script, paths, "1", 0 );
+        check( lower.id != upper.id, "Each case variant of a module is in the key" );
+
+        geRunCache cache( ( fs::path( dir ) / "cache" ).string(), 1 << 20 );
+        std::string output;
+        cache.Store( key, "output\n" );
+        check( cache.Find( key, output ) && output == "output\n", "Find returns the stored output" );
+        geRunKey other = geRunCache::MakeKey( "call lib:g;\n", paths, "1", 0 );
+        other.id = key.id;
+        check( !cache.Find( other, output ), "Find checks the digest" );
+        fs::remove_all( dir );
+    }
+
+}
+
+// Usage: gliched_test <test> [args]
+int main( int argc, char* argv[] )
+{
+    wxInitializer init;
+    if( !init.IsOk() || argc < 2 ) {
+        return 2;
+    }
+    if( std::strcmp( argv[1], "session_pool" ) == 0 && argc > 2 ) {
+        test_session_pool( wxString( "\"" ) + argv[2] + "\" --session --lib none" );
+    }
+    else if( std::strcmp( argv[1], "run_cache" ) == 0 && argc > 2 ) {
+        test_run_cache( argv[2] );
+    }
+    else {
+        std::fprintf( stderr, "Unknown test: %s\n", argv[1] );
+        return 2;
+    }
+    return s_failures == 0 ? 0 : 1;
+}
+
+// End of test/gliched/gtMain.cpp file